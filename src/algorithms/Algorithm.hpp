@@ -1,16 +1,187 @@
 #pragma once
 #include "../problem/Problem.hpp"
+#include "RandomStreams.hpp"
+#include "SharedIncumbent.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Namespace for the algorithm classes
  */
 namespace algorithm {
+	class EvaluationCache;
+	class ElitePool;
+
+	/**
+	 * @brief Optional initial solution of a solve (warm start), e.g. yesterday's plan or another algorithm's output.
+	 */
+	class WarmStart {
+	public:
+		/**
+		 * @brief Later solves start from this open set instead of the algorithm's own start.
+		 * An empty vector, or one with no open warehouse, goes back to the default start.
+		 */
+		void setInitialSolution(const std::vector<bool>& open) {
+			initial_open = open;
+			initial_assignments.clear();
+		}
+
+		/**
+		 * @brief Later solves start from this assignment, or from the warehouses it uses.
+		 */
+		void setInitialSolution(const std::vector<std::pair<int, int>>& assignments) {
+			initial_assignments = assignments;
+			initial_open.clear();
+		}
+
+		bool hasInitialSolution() const {
+			return !initial_open.empty() || !initial_assignments.empty();
+		}
+
+	protected:
+		/**
+		 * @brief The warm-start open set, or an empty vector if there is none.
+		 */
+		std::vector<bool> getInitialOpenSet(const Problem& problem) const {
+			std::vector<bool> open = initial_open;
+			if (!initial_assignments.empty()) {
+				open.assign(problem.getNumberOfWarehouses(), false);
+				for (const auto& assignment : initial_assignments) {
+					if (assignment.second >= 0 && assignment.second < problem.getNumberOfWarehouses()) {
+						open[assignment.second] = true;
+					}
+				}
+			}
+			if (open.size() != static_cast<std::size_t>(problem.getNumberOfWarehouses()) ||
+				std::find(open.begin(), open.end(), true) == open.end()) {
+				open.clear();
+			}
+			return open;
+		}
+
+		/**
+		 * @brief The warehouse of every customer in the warm start (nearest open one for an open set),
+		 * or an empty vector if there is none or it does not fit the problem.
+		 */
+		std::vector<int> getInitialAssignment(const Problem& problem) const {
+			std::vector<int> assignment;
+			if (!initial_assignments.empty()) {
+				if (initial_assignments.size() != static_cast<std::size_t>(problem.getNumberOfCustomers())) {
+					return assignment;
+				}
+				assignment.assign(problem.getNumberOfCustomers(), -1);
+				for (const auto& pair : initial_assignments) {
+					if (pair.first < 0 || pair.first >= problem.getNumberOfCustomers() ||
+						pair.second < 0 || pair.second >= problem.getNumberOfWarehouses()) {
+						return std::vector<int>();
+					}
+					assignment[pair.first] = pair.second;
+				}
+				return std::find(assignment.begin(), assignment.end(), -1) == assignment.end() ? assignment : std::vector<int>();
+			}
+
+			std::vector<bool> open = getInitialOpenSet(problem);
+			if (!open.empty()) {
+				for (const auto& pair : problem.assignToNearest(open)) {
+					if (pair.second < 0) {
+						return std::vector<int>();
+					}
+					assignment.push_back(pair.second);
+				}
+			}
+			return assignment;
+		}
+
+	private:
+		std::vector<bool> initial_open;
+		std::vector<std::pair<int, int>> initial_assignments;
+	};
+
 	/**
 	 * @brief Abstract class for the algorithms
 	 */
-	class Algorithm {
+	class Algorithm : public WarmStart {
 	public:
 		virtual std::vector<std::pair<int, int>> solve(const Problem& problem) const = 0;
 		virtual ~Algorithm() {}
+
+		/**
+		 * @brief Shares an open-set cost cache with other solves of the same problem instance.
+		 * Algorithms that evaluate whole open sets use it instead of a private cache.
+		 */
+		void shareEvaluationCache(EvaluationCache* cache) {
+			evaluation_cache = cache;
+		}
+
+		/**
+		 * @brief Shares an elite pool. Algorithms offer the good solutions they meet to it,
+		 * so a later path-relinking stage can combine the results of different algorithms.
+		 */
+		void shareElitePool(ElitePool* pool) {
+			elite_pool = pool;
+		}
+
+		/**
+		 * @brief Shares the best solution with concurrent solvers. Algorithms offer their new
+		 * best solutions to it, and those that bound their search prune against it.
+		 */
+		void shareIncumbent(SharedIncumbent* shared) {
+			incumbent = shared;
+		}
+
+		SharedIncumbent* getSharedIncumbent() const {
+			return incumbent;
+		}
+
+		/**
+		 * @brief Flag checked between iterations; once it is set, the solve returns the best solution found so far.
+		 */
+		void shareStopFlag(const std::atomic<bool>* flag) {
+			stop_flag = flag;
+		}
+
+		const std::atomic<bool>* getStopFlag() const {
+			return stop_flag;
+		}
+
+		/**
+		 * @brief Master seed of later solves; 0 by default. Every random stream of a solve, per
+		 * restart or per thread, is derived from it, so a solve repeated with the same seed and
+		 * thread count gives the same result bit for bit; BranchAndBoundAlgorithm documents its exceptions.
+		 */
+		void setSeed(std::uint64_t seed) {
+			master_seed = seed;
+		}
+
+		std::uint64_t getSeed() const {
+			return master_seed;
+		}
+
+	protected:
+		bool stopRequested() const {
+			return stop_flag != nullptr && stop_flag->load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Seed of one random stream of the solve; see deriveSeed.
+		 */
+		std::uint64_t streamSeed(std::uint64_t stream) const {
+			return deriveSeed(master_seed, stream);
+		}
+
+		void offerIncumbent(double cost, const std::vector<bool>& open) const {
+			if (incumbent != nullptr) {
+				incumbent->offer(cost, open, this);
+			}
+		}
+
+		EvaluationCache* evaluation_cache = nullptr;
+		ElitePool* elite_pool = nullptr;
+		SharedIncumbent* incumbent = nullptr;
+		const std::atomic<bool>* stop_flag = nullptr;
+		std::uint64_t master_seed = 0;
 	};
 }
\ No newline at end of file
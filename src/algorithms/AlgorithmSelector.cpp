@@ -0,0 +1,233 @@
+#include "AlgorithmSelector.hpp"
+#include "BranchAndBoundAlgorithm.hpp"
+#include "CrowSearchAlgorithm.hpp"
+#include "GRASP.hpp"
+#include "GeneticAlgorithm.hpp"
+#include "HillClimbingAlgorithm.hpp"
+#include "PortfolioAlgorithm.hpp"
+#include "SimulatedAnnealingAlgorithm.hpp"
+#include "TabuSearchAlgorithm.hpp"
+#include "VariableNeighbourhoodSearch.hpp"
+#include "../misc/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace algorithm {
+
+    void AlgorithmSelector::addCandidate(const std::string& name, Factory factory) {
+        candidates.emplace_back(name, std::move(factory));
+    }
+
+    void AlgorithmSelector::addDefaultCandidates() {
+        addCandidate("HC", [] { return std::make_shared<HillClimbingAlgorithm>(); });
+        addCandidate("GRASP alpha=0.1 iterations=10", [] { return std::make_shared<GRASPAlgorithm>(0.1, 10); });
+        addCandidate("GRASP alpha=0.5 iterations=10", [] { return std::make_shared<GRASPAlgorithm>(0.5, 10); });
+        addCandidate("SA T0=1000 Tf=0.1 cooling=0.9 L=200", [] { return std::make_shared<SimulatedAnnealingAlgorithm>(1000, 0.1, 0.9, 200); });
+        addCandidate("CSA population=400 AP=0.1 evaluations=80000", [] { return std::make_shared<CrowSearchAlgorithm>(400, 0.1, 80000); });
+        addCandidate("Tabu iterations=10000 tenure=10 stall=1000", [] { return std::make_shared<TabuSearchAlgorithm>(10000, 10, 1000); });
+        addCandidate("VNS kmax=3 iterations=20", [] { return std::make_shared<VariableNeighbourhoodSearch>(3, 20); });
+        addCandidate("VNS kmax=5 iterations=50", [] { return std::make_shared<VariableNeighbourhoodSearch>(5, 50); });
+        addCandidate("GA population=40 generations=100", [] { return std::make_shared<GeneticAlgorithm>(40, 100); });
+        addCandidate("BnB", [] { return std::make_shared<BranchAndBoundAlgorithm>(); });
+    }
+
+    std::vector<std::string> AlgorithmSelector::getCandidates() const {
+        std::vector<std::string> names;
+        for (const auto& candidate : candidates) {
+            names.push_back(candidate.first);
+        }
+        return names;
+    }
+
+    std::shared_ptr<Algorithm> AlgorithmSelector::create(const std::string& name) const {
+        for (const auto& candidate : candidates) {
+            if (candidate.first == name) {
+                return candidate.second();
+            }
+        }
+        throw std::invalid_argument("Unknown candidate: " + name);
+    }
+
+    void AlgorithmSelector::addObservation(const InstanceFeatures& features, const std::string& candidate, double cost, double seconds) {
+        observations.push_back({ features, candidate, cost, seconds });
+    }
+
+    void AlgorithmSelector::train(const Problem& problem, double time_limit) {
+        InstanceFeatures features = InstanceFeatures::extract(problem);
+        for (const auto& candidate : candidates) {
+            // A one-engine portfolio gives the run a budget and times its best cost
+            PortfolioAlgorithm run(time_limit);
+            run.addEngine(candidate.first, candidate.second());
+            run.solve(problem);
+            const PortfolioAlgorithm::EngineResult& result = run.getResults().front();
+            addObservation(features, candidate.first, result.cost, result.seconds);
+            UFLP_LOG_DEBUG("Selector training: %s reached %f after %.3f s", candidate.first.c_str(), result.cost, result.seconds);
+        }
+    }
+
+    void AlgorithmSelector::load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Could not open selector training file: " + path);
+        }
+
+        std::string line;
+        std::getline(file, line); // Header
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+
+            std::vector<std::string> fields;
+            std::stringstream stream(line);
+            std::string field;
+            while (std::getline(stream, field, ',')) {
+                fields.push_back(field);
+            }
+            if (fields.size() != 9) {
+                throw std::runtime_error("Malformed selector training row: " + line);
+            }
+
+            Observation observation;
+            try {
+                observation.features.customers = std::stoi(fields[0]);
+                observation.features.warehouses = std::stoi(fields[1]);
+                observation.features.density = std::stod(fields[2]);
+                observation.features.cost_spread = std::stod(fields[3]);
+                observation.features.fixed_to_allocation = std::stod(fields[4]);
+                observation.features.fixed_spread = std::stod(fields[5]);
+                observation.candidate = fields[6];
+                observation.cost = std::stod(fields[7]);
+                observation.seconds = std::stod(fields[8]);
+            }
+            catch (const std::logic_error&) {
+                throw std::runtime_error("Malformed selector training row: " + line);
+            }
+            observations.push_back(observation);
+        }
+    }
+
+    void AlgorithmSelector::save(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Could not write selector training file: " + path);
+        }
+
+        file << "customers,warehouses,density,cost_spread,fixed_to_allocation,fixed_spread,candidate,cost,seconds\n";
+        file.precision(17);
+        for (const auto& observation : observations) {
+            const InstanceFeatures& features = observation.features;
+            file << features.customers << ',' << features.warehouses << ',' << features.density << ','
+                 << features.cost_spread << ',' << features.fixed_to_allocation << ',' << features.fixed_spread << ','
+                 << observation.candidate << ',' << observation.cost << ',' << observation.seconds << '\n';
+        }
+        if (!file) {
+            throw std::runtime_error("Could not write selector training file: " + path);
+        }
+    }
+
+    std::string AlgorithmSelector::select(const InstanceFeatures& features) const {
+        if (candidates.empty()) {
+            throw std::logic_error("The selector has no candidates");
+        }
+
+        // Group the observations by instance; for every candidate keep its best run there
+        struct Instance {
+            std::vector<double> point;
+            std::map<std::string, std::pair<double, double>> runs; // Candidate -> (cost, seconds)
+        };
+        std::vector<Instance> instances;
+        for (const auto& observation : observations) {
+            std::vector<double> point = observation.features.toVector();
+            auto it = std::find_if(instances.begin(), instances.end(), [&point](const Instance& instance) { return instance.point == point; });
+            if (it == instances.end()) {
+                instances.push_back({ point, {} });
+                it = instances.end() - 1;
+            }
+            auto run = it->runs.find(observation.candidate);
+            std::pair<double, double> result(observation.cost, observation.seconds);
+            if (run == it->runs.end()) {
+                it->runs.emplace(observation.candidate, result);
+            }
+            else if (result < run->second) {
+                run->second = result;
+            }
+        }
+        if (instances.empty()) {
+            return candidates.front().first;
+        }
+
+        // Standardise every feature by its spread over the trained instances and the query
+        std::vector<double> query = features.toVector();
+        std::vector<double> scale(query.size(), 0.0);
+        for (std::size_t d = 0; d < query.size(); ++d) {
+            double sum = query[d], sum_of_squares = query[d] * query[d];
+            for (const auto& instance : instances) {
+                sum += instance.point[d];
+                sum_of_squares += instance.point[d] * instance.point[d];
+            }
+            double count = static_cast<double>(instances.size() + 1);
+            double mean = sum / count;
+            scale[d] = std::sqrt(std::max(0.0, sum_of_squares / count - mean * mean));
+        }
+
+        std::vector<std::pair<double, std::size_t>> distances;
+        for (std::size_t k = 0; k < instances.size(); ++k) {
+            double distance = 0.0;
+            for (std::size_t d = 0; d < query.size(); ++d) {
+                if (scale[d] > 0.0) {
+                    double difference = (instances[k].point[d] - query[d]) / scale[d];
+                    distance += difference * difference;
+                }
+            }
+            distances.emplace_back(distance, k);
+        }
+        std::size_t voters = std::min(instances.size(), static_cast<std::size_t>(std::max(1, neighbours)));
+        std::partial_sort(distances.begin(), distances.begin() + voters, distances.end());
+
+        std::vector<double> scores(candidates.size(), 0.0);
+        for (std::size_t v = 0; v < voters; ++v) {
+            const Instance& instance = instances[distances[v].second];
+            double best = std::numeric_limits<double>::infinity();
+            double slowest = 0.0;
+            for (const auto& run : instance.runs) {
+                best = std::min(best, run.second.first);
+                slowest = std::max(slowest, run.second.second);
+            }
+            double target = best + tolerance * std::max(1.0, std::abs(best));
+            double penalty = 10.0 * std::max(slowest, 1e-3);
+
+            for (std::size_t c = 0; c < candidates.size(); ++c) {
+                auto run = instance.runs.find(candidates[c].first);
+                bool reached = run != instance.runs.end() && run->second.first <= target;
+                scores[c] += std::log(1e-3 + (reached ? run->second.second : penalty));
+            }
+        }
+
+        std::size_t chosen = std::min_element(scores.begin(), scores.end()) - scores.begin();
+        return candidates[chosen].first;
+    }
+
+    std::vector<std::pair<int, int>> AlgorithmSelector::solve(const Problem& problem) const {
+        selected = select(InstanceFeatures::extract(problem));
+        UFLP_LOG_INFO("Selector: running %s", selected.c_str());
+
+        std::shared_ptr<Algorithm> engine = create(selected);
+        // The warm start goes through as given, an assignment included, not reduced to its open set
+        static_cast<WarmStart&>(*engine) = static_cast<const WarmStart&>(*this);
+        engine->shareEvaluationCache(evaluation_cache);
+        engine->shareElitePool(elite_pool);
+        engine->shareIncumbent(incumbent);
+        engine->shareStopFlag(stop_flag);
+        engine->setSeed(master_seed);
+        return engine->solve(problem);
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "Algorithm.hpp"
+#include "../problem/InstanceFeatures.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Picks the algorithm and parameters expected to reach the target quality fastest on an instance.
+     *
+     * A candidate is a named, fully parameterised algorithm. The selector is trained with
+     * observations (instance features, candidate, best cost, seconds to that cost), e.g. from
+     * train() or from a CSV written by the selector_training harness. For a new instance it
+     * finds the nearest trained instances in standardised feature space and, on each of them,
+     * scores every candidate by its time to reach the best cost seen on that instance (within
+     * the tolerance); a candidate that missed it, or was never run there, is charged ten times
+     * the slowest time recorded on that instance. The candidate with the lowest geometric mean
+     * over the neighbours is chosen. Without observations the first candidate is chosen.
+     *
+     * As an Algorithm, solve() extracts the features, selects a candidate and runs it, passing
+     * on the warm start, the shared incumbent and the stop flag.
+     */
+    class AlgorithmSelector : public Algorithm {
+    public:
+        using Factory = std::function<std::shared_ptr<Algorithm>()>;
+
+        struct Observation {
+            InstanceFeatures features;
+            std::string candidate;
+            double cost;
+            double seconds;
+        };
+
+        /**
+         * @param neighbours Number of nearest trained instances that vote.
+         * @param tolerance Relative gap to an instance's best cost that still counts as reaching it.
+         */
+        explicit AlgorithmSelector(int neighbours = 3, double tolerance = 1e-6)
+            : neighbours(neighbours), tolerance(tolerance) {}
+
+        void addCandidate(const std::string& name, Factory factory);
+
+        /**
+         * @brief Adds the parameterisations used by the tests and the portfolio, plus a few variants.
+         */
+        void addDefaultCandidates();
+
+        std::vector<std::string> getCandidates() const;
+
+        /**
+         * @brief A new instance of the named candidate. Throws std::invalid_argument for an unknown name.
+         */
+        std::shared_ptr<Algorithm> create(const std::string& name) const;
+
+        void addObservation(const InstanceFeatures& features, const std::string& candidate, double cost, double seconds);
+        const std::vector<Observation>& getObservations() const { return observations; }
+
+        /**
+         * @brief Runs every candidate alone on the problem and records its best cost and the time it took.
+         *
+         * @param time_limit Budget of every run in seconds; 0 lets the candidates run to their own limits.
+         */
+        void train(const Problem& problem, double time_limit = 0.0);
+
+        /**
+         * @brief Appends the observations of a CSV file written by save(). Throws std::runtime_error if it cannot be read.
+         */
+        void load(const std::string& path);
+
+        /**
+         * @brief Writes the observations as CSV, one row per observation. Throws std::runtime_error on failure.
+         */
+        void save(const std::string& path) const;
+
+        /**
+         * @brief Name of the candidate expected to reach the target quality fastest. Throws std::logic_error without candidates.
+         */
+        std::string select(const InstanceFeatures& features) const;
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+        /**
+         * @brief Name of the candidate run by the last solve.
+         */
+        std::string getSelected() const { return selected; }
+
+    private:
+        int neighbours;
+        double tolerance;
+        std::vector<std::pair<std::string, Factory>> candidates;
+        std::vector<Observation> observations;
+        mutable std::string selected;
+    };
+}
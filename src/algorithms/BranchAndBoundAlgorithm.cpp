@@ -0,0 +1,415 @@
+#include "BranchAndBoundAlgorithm.hpp"
+#include "IncrementalEvaluator.hpp"
+#include "../misc/Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace algorithm {
+
+    namespace {
+        const double INFINITE_COST = std::numeric_limits<double>::infinity();
+        const double TOLERANCE = 1e-9;
+
+        enum FacilityStatus : char {
+            FREE = 0,
+            FORCED_OPEN = 1,
+            FORCED_CLOSED = 2
+        };
+
+        /**
+         * @brief A subproblem: the facility fixings plus the dual values it inherits from its parent.
+         */
+        struct Node {
+            std::vector<char> status;
+            std::vector<double> dual;
+        };
+
+        /**
+         * @brief Node-independent data: for each customer, the facilities that can serve it sorted by allocation cost.
+         *
+         * Rows are stored one after the other, as in SparseCosts: a sparse problem keeps only its stored pairs,
+         * a dense one every facility.
+         */
+        struct Instance {
+            int number_of_customers;
+            int number_of_warehouses;
+            std::vector<double> fixed_costs;
+            std::vector<std::size_t> row_offsets;
+            std::vector<int> facilities;
+            std::vector<double> costs;
+
+            explicit Instance(const Problem& problem)
+                : number_of_customers(problem.getNumberOfCustomers()),
+                  number_of_warehouses(problem.getNumberOfWarehouses()),
+                  fixed_costs(number_of_warehouses),
+                  row_offsets(number_of_customers + 1, 0) {
+                for (int i = 0; i < number_of_warehouses; ++i) {
+                    fixed_costs[i] = problem.getWarehouses()[i].getFixedCost();
+                }
+
+                // A sparse problem's rows are already sorted, cheapest first
+                if (std::shared_ptr<const SparseCosts> sparse = problem.getSparseCosts()) {
+                    facilities.reserve(sparse->getNonZeroCount());
+                    costs.reserve(sparse->getNonZeroCount());
+                    for (int j = 0; j < number_of_customers; ++j) {
+                        for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j); ++e) {
+                            facilities.push_back(sparse->getFacility(e));
+                            costs.push_back(sparse->getCost(e));
+                        }
+                        row_offsets[j + 1] = facilities.size();
+                    }
+                    return;
+                }
+
+                facilities.resize(static_cast<std::size_t>(number_of_customers) * number_of_warehouses);
+                costs.resize(facilities.size());
+                for (int j = 0; j < number_of_customers; ++j) {
+                    const auto& allocation_costs = problem.getCustomers()[j].getAllocationCosts();
+                    int* sorted = &facilities[static_cast<std::size_t>(j) * number_of_warehouses];
+                    std::iota(sorted, sorted + number_of_warehouses, 0);
+                    std::sort(sorted, sorted + number_of_warehouses,
+                              [&allocation_costs](int a, int b) { return allocation_costs[a] < allocation_costs[b]; });
+                    for (int k = 0; k < number_of_warehouses; ++k) {
+                        costs[static_cast<std::size_t>(j) * number_of_warehouses + k] = allocation_costs[sorted[k]];
+                    }
+                    row_offsets[j + 1] = static_cast<std::size_t>(j + 1) * number_of_warehouses;
+                }
+            }
+
+            std::size_t rowBegin(int j) const { return row_offsets[j]; }
+            std::size_t rowEnd(int j) const { return row_offsets[j + 1]; }
+        };
+
+        /**
+         * @brief Erlenkotter's dual ascent for the node, warm-started from node.dual.
+         *
+         * Maximises sum(v_j) subject to sum_j max(0, v_j - c_ij) <= f_i for every free facility,
+         * v_j <= c_ij for every forced-open facility, and ignores forced-closed ones. Each customer is
+         * raised one breakpoint (the next allocation cost above v_j) per round, limited by the slack
+         * of the facilities it already reaches, until no customer can move.
+         *
+         * @return The lower bound, or infinity if some customer has no facility left.
+         */
+        double dualAscent(const Instance& instance, Node& node, std::vector<double>& slack) {
+            const int n = instance.number_of_customers;
+            const int m = instance.number_of_warehouses;
+            std::vector<double>& dual = node.dual;
+
+            double forced_fixed = 0.0;
+            for (int i = 0; i < m; ++i) {
+                slack[i] = node.status[i] == FREE ? instance.fixed_costs[i] : 0.0;
+                if (node.status[i] == FORCED_OPEN) {
+                    forced_fixed += instance.fixed_costs[i];
+                }
+            }
+
+            for (int j = 0; j < n; ++j) {
+                std::size_t first = instance.rowBegin(j);
+                while (first < instance.rowEnd(j) && node.status[instance.facilities[first]] == FORCED_CLOSED) {
+                    ++first;
+                }
+                if (first == instance.rowEnd(j)) {
+                    return INFINITE_COST;
+                }
+                for (std::size_t e = first; e < instance.rowEnd(j); ++e) {
+                    if (node.status[instance.facilities[e]] == FORCED_OPEN) {
+                        dual[j] = std::min(dual[j], instance.costs[e]);
+                        break;
+                    }
+                }
+            }
+
+            for (int j = 0; j < n; ++j) {
+                for (std::size_t e = instance.rowBegin(j); e < instance.rowEnd(j) && instance.costs[e] < dual[j]; ++e) {
+                    if (node.status[instance.facilities[e]] != FORCED_CLOSED) {
+                        slack[instance.facilities[e]] -= dual[j] - instance.costs[e];
+                    }
+                }
+            }
+            for (int i = 0; i < m; ++i) {
+                slack[i] = std::max(slack[i], 0.0);
+            }
+
+            bool changed = true;
+            while (changed) {
+                changed = false;
+
+                for (int j = 0; j < n; ++j) {
+                    double limit = INFINITE_COST;
+                    double next = INFINITE_COST;
+
+                    for (std::size_t e = instance.rowBegin(j); e < instance.rowEnd(j); ++e) {
+                        int i = instance.facilities[e];
+                        if (node.status[i] == FORCED_CLOSED) {
+                            continue;
+                        }
+                        double c = instance.costs[e];
+                        if (c > dual[j]) {
+                            next = c;
+                            break;
+                        }
+                        limit = std::min(limit, slack[i]);
+                    }
+
+                    double increase = std::min(limit, next - dual[j]);
+                    if (!(increase > TOLERANCE * std::max(1.0, std::abs(dual[j]))) || increase == INFINITE_COST) {
+                        continue;
+                    }
+
+                    for (std::size_t e = instance.rowBegin(j); e < instance.rowEnd(j); ++e) {
+                        int i = instance.facilities[e];
+                        if (node.status[i] == FORCED_CLOSED) {
+                            continue;
+                        }
+                        if (instance.costs[e] > dual[j]) {
+                            break;
+                        }
+                        slack[i] = std::max(slack[i] - increase, 0.0);
+                    }
+                    dual[j] += increase;
+                    changed = true;
+                }
+            }
+
+            return forced_fixed + std::accumulate(dual.begin(), dual.end(), 0.0);
+        }
+
+        /**
+         * @brief Deque of nodes owned by one worker. The owner works on the back, thieves take the front.
+         */
+        class WorkQueue {
+        public:
+            void push(Node&& node) {
+                std::lock_guard<std::mutex> lock(mutex);
+                nodes.push_back(std::move(node));
+            }
+
+            bool pop(Node& node) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (nodes.empty()) {
+                    return false;
+                }
+                node = std::move(nodes.back());
+                nodes.pop_back();
+                return true;
+            }
+
+            bool steal(Node& node) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (nodes.empty()) {
+                    return false;
+                }
+                node = std::move(nodes.front());
+                nodes.pop_front();
+                return true;
+            }
+
+        private:
+            std::mutex mutex;
+            std::deque<Node> nodes;
+        };
+
+        struct SearchState {
+            const Instance& instance;
+            const Problem& problem;
+            SharedIncumbent& incumbent;
+            const void* source; // Named in the offers to the incumbent
+            std::vector<WorkQueue> queues;
+            std::atomic<long long> pending{ 0 };
+            std::atomic<long long> explored{ 0 };
+            std::atomic<bool> aborted{ false };
+            long long node_limit;
+            const std::atomic<bool>* stop;
+
+            SearchState(const Instance& instance, const Problem& problem, SharedIncumbent& incumbent, const void* source, int workers,
+                        long long node_limit, const std::atomic<bool>* stop)
+                : instance(instance), problem(problem), incumbent(incumbent), source(source), queues(workers), node_limit(node_limit), stop(stop) {}
+        };
+
+        bool canPrune(double lower_bound, double upper_bound) {
+            return lower_bound >= upper_bound - TOLERANCE * std::max(1.0, std::abs(upper_bound));
+        }
+
+        /**
+         * @brief Bounds one node, offers its primal solution and pushes its children.
+         */
+        void processNode(SearchState& state, Node& node, int worker, IncrementalEvaluator& evaluator,
+                         std::vector<double>& slack, std::vector<double>& deltas) {
+            const Instance& instance = state.instance;
+            const int n = instance.number_of_customers;
+            const int m = instance.number_of_warehouses;
+
+            double lower_bound = dualAscent(instance, node, slack);
+            if (canPrune(lower_bound, state.incumbent.getCost())) {
+                return;
+            }
+
+            std::vector<bool> primal(m, false);
+            for (int i = 0; i < m; ++i) {
+                if (node.status[i] == FORCED_OPEN ||
+                    (node.status[i] == FREE && slack[i] <= TOLERANCE * std::max(1.0, instance.fixed_costs[i]))) {
+                    primal[i] = true;
+                }
+            }
+            // Only facilities in the customer's row count, so every customer ends up with one it can use
+            for (int j = 0; j < n; ++j) {
+                bool covered = false;
+                int first_available = -1;
+                for (std::size_t e = instance.rowBegin(j); e < instance.rowEnd(j) && !covered; ++e) {
+                    int i = instance.facilities[e];
+                    if (node.status[i] == FORCED_CLOSED) {
+                        continue;
+                    }
+                    if (first_available == -1) {
+                        first_available = i;
+                    }
+                    covered = primal[i];
+                }
+                if (!covered) {
+                    primal[first_available] = true;
+                }
+            }
+
+            evaluator.reset(primal);
+            double primal_cost = evaluator.getCost();
+            std::vector<int> served(m, 0);
+            for (int j = 0; j < n; ++j) {
+                ++served[evaluator.getNearest(j)];
+            }
+
+            while (true) {
+                evaluator.computeFlipDeltas(deltas);
+                int best = static_cast<int>(std::min_element(deltas.begin(), deltas.end()) - deltas.begin());
+                if (!(deltas[best] < -TOLERANCE * std::max(1.0, std::abs(evaluator.getCost())))) {
+                    break;
+                }
+                evaluator.flip(best);
+            }
+            // Re-evaluated from scratch, so the same open set is offered at the same cost whatever
+            // flips led to it, and equal-cost optima tie exactly in the incumbent
+            evaluator.reset(evaluator.getOpenWarehouses());
+            if (state.incumbent.offer(evaluator.getCost(), evaluator.getOpenWarehouses(), state.source)) {
+                UFLP_LOG_DEBUG("Branch-and-bound incumbent %f (node bound %f)", evaluator.getCost(), lower_bound);
+            }
+
+            if (canPrune(lower_bound, std::min(primal_cost, state.incumbent.getCost()))) {
+                return;
+            }
+
+            int branch = -1;
+            for (int i = 0; i < m; ++i) {
+                if (node.status[i] == FREE && primal[i] && (branch == -1 || served[i] > served[branch])) {
+                    branch = i;
+                }
+            }
+            if (branch == -1) {
+                for (int i = 0; i < m; ++i) {
+                    if (node.status[i] == FREE && (branch == -1 || slack[i] < slack[branch])) {
+                        branch = i;
+                    }
+                }
+            }
+            if (branch == -1) {
+                return;
+            }
+
+            Node closed_child{ node.status, node.dual };
+            closed_child.status[branch] = FORCED_CLOSED;
+            node.status[branch] = FORCED_OPEN;
+
+            state.pending.fetch_add(2);
+            state.queues[worker].push(std::move(closed_child));
+            state.queues[worker].push(std::move(node));
+        }
+
+        void runWorker(SearchState& state, int worker) {
+            const int workers = static_cast<int>(state.queues.size());
+            IncrementalEvaluator evaluator(state.problem);
+            std::vector<double> slack(state.instance.number_of_warehouses);
+            std::vector<double> deltas;
+            Node node;
+
+            while (!state.aborted.load(std::memory_order_relaxed)) {
+                bool found = state.queues[worker].pop(node);
+                for (int k = 1; k < workers && !found; ++k) {
+                    found = state.queues[(worker + k) % workers].steal(node);
+                }
+
+                if (!found) {
+                    if (state.pending.load() == 0) {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (state.explored.fetch_add(1) >= state.node_limit || (state.stop != nullptr && state.stop->load(std::memory_order_relaxed))) {
+                    state.aborted.store(true);
+                    return;
+                }
+
+                processNode(state, node, worker, evaluator, slack, deltas);
+                state.pending.fetch_sub(1);
+            }
+        }
+    }
+
+    /**
+     * @brief Solves the problem to optimality (unless the node limit is reached or a stop is requested).
+     *
+     * @param problem The problem instance to solve.
+     * @return A vector of pairs representing the assignment of customers to warehouses.
+     */
+    std::vector<std::pair<int, int>> BranchAndBoundAlgorithm::solve(const Problem& problem) const {
+        Instance instance(problem);
+
+        SharedIncumbent local_incumbent;
+        SharedIncumbent& shared = incumbent != nullptr ? *incumbent : local_incumbent;
+
+        int workers = number_of_threads > 0 ? number_of_threads : static_cast<int>(std::thread::hardware_concurrency());
+        workers = std::max(workers, 1);
+
+        SearchState state(instance, problem, shared, this, workers, node_limit, stop_flag);
+
+        // A warm start is a first upper bound, so pruning starts at the root
+        std::vector<bool> start = getInitialOpenSet(problem);
+        if (!start.empty()) {
+            IncrementalEvaluator start_evaluator(problem);
+            start_evaluator.reset(start);
+            shared.offer(start_evaluator.getCost(), start);
+        }
+
+        Node root;
+        root.status.assign(instance.number_of_warehouses, FREE);
+        root.dual.assign(instance.number_of_customers, 0.0);
+        state.pending.store(1);
+        state.queues[0].push(std::move(root));
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < workers; ++t) {
+            threads.emplace_back(runWorker, std::ref(state), t);
+        }
+        runWorker(state, 0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (state.aborted.load()) {
+            UFLP_LOG_WARNING("Branch-and-bound stopped after %lld nodes; best cost %f is not proven optimal",
+                             state.explored.load(), shared.getCost());
+        }
+        else {
+            UFLP_LOG_INFO("Branch-and-bound proved optimality of %f in %lld nodes", shared.getCost(), state.explored.load());
+        }
+
+        IncrementalEvaluator evaluator(problem);
+        evaluator.reset(shared.getOpenWarehouses());
+        return evaluator.getAssignments();
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Algorithm.hpp"
+#include "SharedIncumbent.hpp"
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Exact solver: depth-first branch-and-bound over facility open/close decisions.
+     *
+     * Each node is bounded with Erlenkotter's dual ascent (DUALOC), warm-started from the dual
+     * solution of its parent, so a child only has to repair the duals touched by its one new
+     * fixing. The facilities left tight by the ascent give a primal solution that is polished
+     * by a flip descent and offered to the incumbent. Nodes are explored by several threads,
+     * each working depth-first on its own deque and stealing the shallowest node of another
+     * thread when it runs dry. A shared incumbent (Algorithm::shareIncumbent) is pruned against and published to.
+     *
+     * A search that runs to completion returns an optimal cost whatever the thread count. Among
+     * several optimal open sets it returns the lexicographically smallest one that was offered,
+     * but which ones are offered before pruning depends on thread timing. With more than one
+     * thread, equal-cost optima and runs cut short by the node limit or a stop request are
+     * therefore not reproducible bit for bit from the seed.
+     */
+    class BranchAndBoundAlgorithm : public Algorithm {
+    public:
+        /**
+         * @param number_of_threads Worker threads; 0 uses the hardware concurrency.
+         * @param node_limit Maximum number of nodes to explore; the result is only proven optimal if it is not hit.
+         */
+        BranchAndBoundAlgorithm(int number_of_threads = 0, long long node_limit = 1000000)
+            : number_of_threads(number_of_threads), node_limit(node_limit) {}
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+    private:
+        int number_of_threads;
+        long long node_limit;
+    };
+}
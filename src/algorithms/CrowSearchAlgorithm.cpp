@@ -1,61 +1,28 @@
     #include "CrowSearchAlgorithm.hpp"
+    #include "EvaluationCache.hpp"
+    #include "../misc/Logger.hpp"
     #include <random>
     #include <algorithm>
-    #include <ctime>
     #include <cmath>
     #include <cfloat>
     #include <vector>
-    #include <iostream>
 
     namespace algorithm {
 
-        std::default_random_engine generator(static_cast<unsigned>(std::time(nullptr)));
-
-        double CrowSearchAlgorithm::closed_interval_rand(double x0, double x1) {
+        double CrowSearchAlgorithm::closed_interval_rand(std::mt19937& generator, double x0, double x1) {
             std::uniform_real_distribution<double> distribution(x0, x1);
             return distribution(generator);
         }
 
-        double CrowSearchAlgorithm::UFLP(int loc, int cus, const std::vector<std::vector<double>>& customer,
-            const std::vector<double>& location, const std::vector<bool>& per)
-        {
-            double cost = 0;
-            double min_cost = 0;
-            for (int i = 0; i < loc; ++i)
-                if (per[i])
-                    cost += location[i];
-
-            for (int i = 0; i < cus; ++i) {
-                min_cost = DBL_MAX;
-                for (int j = 0; j < loc; ++j) {
-                    if (per[j] && customer[i][j] < min_cost)
-                        min_cost = customer[i][j];
-                }
-                cost += min_cost;
-            }
-
-            return cost;
-        }
-
         std::vector<std::pair<int, int>> CrowSearchAlgorithm::solve(const Problem& problem) const {
             int loc = problem.getNumberOfWarehouses();
-            int cus = problem.getNumberOfCustomers();
-
-            const auto& customers = problem.getCustomers();
-            const auto& warehouses = problem.getWarehouses();
-
-            std::vector<double> location(loc);
-            std::vector<std::vector<double>> customer(cus, std::vector<double>(loc));
 
-            for (int i = 0; i < loc; ++i)
-                location[i] = warehouses[i].getFixedCost();
+            // Every draw of the solve comes from one stream of the master seed
+            std::mt19937 generator;
+            seedEngine(generator, streamSeed(0));
 
-            for (int i = 0; i < cus; ++i) {
-                const std::vector<double>& costs = customers[i].getAllocationCosts();
-                for (int j = 0; j < loc; ++j) {
-                    customer[i][j] = costs[j];
-                }
-            }
+            // Searched in the problem's search precision, re-scored exactly at the end
+            std::shared_ptr<const CostMatrix> costs = problem.getSearchCosts();
 
             const int N = population_size;  // Population size
             const double AP = awareness_probability;  // Awareness probability
@@ -72,12 +39,39 @@
 
             double global_best = DBL_MAX;
 
+            // Crows that did not move, or moved back onto a known position, are not re-evaluated
+            EvaluationCache local_cache(loc);
+            EvaluationCache& cache = evaluation_cache != nullptr ? *evaluation_cache : local_cache;
+            // The rest of the flock is evaluated in one tiled sweep of the cost matrix
+            std::vector<const std::vector<bool>*> batch;
+            std::vector<int> batch_owner;
+            std::vector<std::uint64_t> batch_hash;
+            std::vector<double> batch_cost;
+            auto evaluateFlock = [&](const std::vector<std::vector<bool>>& positions, std::vector<double>& objectives) {
+                batch.clear();
+                batch_owner.clear();
+                batch_hash.clear();
+                for (int i = 0; i < N; i++) {
+                    std::uint64_t hash = cache.hash(positions[i]);
+                    if (!cache.lookup(hash, objectives[i])) {
+                        batch.push_back(&positions[i]);
+                        batch_owner.push_back(i);
+                        batch_hash.push_back(hash);
+                    }
+                }
+                costs->evaluateBatch(batch, batch_cost);
+                for (std::size_t b = 0; b < batch.size(); ++b) {
+                    objectives[batch_owner[b]] = batch_cost[b];
+                    cache.store(batch_hash[b], batch_cost[b]);
+                }
+            };
+
             std::vector<std::pair<int, int>> final_assignments;
 
             // Memory initialization with more strategic approach
             for (int i = 0; i < N; i++) {
                 for (int j = 0; j < loc; j++) {
-                    if (closed_interval_rand(0, 1) < 0.5) {
+                    if (closed_interval_rand(generator, 0, 1) < 0.5) {
                         x_crows[i][j] = false;
                         x_memory[i][j] = false;
                         continue;
@@ -87,15 +81,19 @@
                 }
             }
 
-            for (int i = 0; i < N; i++) {
-                obj_memory[i] = UFLP(loc, cus, customer, location, x_crows[i]);
+            // A warm start takes the place of the first crow
+            std::vector<bool> start = getInitialOpenSet(problem);
+            if (!start.empty() && N > 0) {
+                x_crows[0] = start;
+                x_memory[0] = start;
             }
 
+            evaluateFlock(x_crows, obj_memory);
+
             // Iterations start
-            for (int iter = 0; iter < MAX_ITER; iter++) {
+            for (int iter = 0; iter < MAX_ITER && !stopRequested(); iter++) {
+                evaluateFlock(x_crows, obj_crows);
                 for (int i = 0; i < N; i++) {
-                    obj_crows[i] = UFLP(loc, cus, customer, location, x_crows[i]);
-
                     if (obj_crows[i] < obj_memory[i]) {
                         obj_memory[i] = obj_crows[i];
 
@@ -106,41 +104,32 @@
 
                     if (obj_memory[i] < global_best) {
                         global_best = obj_memory[i];
-                        final_assignments.clear();
-
-                        // Update final_assignments with the new best assignments
-                        for (int k = 0; k < cus; ++k) {
-                            int warehouse_index = -1;
-                            double min_cost = DBL_MAX;
-                            for (int j = 0; j < loc; ++j) {
-                                if (x_memory[i][j] && customer[k][j] < min_cost) {
-                                    min_cost = customer[k][j];
-                                    warehouse_index = j;
-                                }
-                            }
-                            final_assignments.emplace_back(k, warehouse_index);
-                        }
+                        final_assignments = problem.assignToNearest(x_memory[i]);
                     }
                 }
 
                 for (int i = 0; i < N; ++i) {
-                    follow[i] = std::ceil(N * closed_interval_rand(0, 1)) - 1;
+                    follow[i] = std::ceil(N * closed_interval_rand(generator, 0, 1)) - 1;
                 }
 
                 for (int i = 0; i < N; ++i) {
-                    if (closed_interval_rand(0, 1) > AP) {
+                    if (closed_interval_rand(generator, 0, 1) > AP) {
                         for (int j = 0; j < loc; ++j) {
-                            x_crows[i][j] = x_memory[i][j] ^ ((std::rand() & 1) & (x_memory[follow[i]][j] ^ x_memory[i][j]));
+                            x_crows[i][j] = x_memory[i][j] ^ ((generator() & 1) & (x_memory[follow[i]][j] ^ x_memory[i][j]));
                         }
                     }
                     else {
                         for (int j = 0; j < loc; ++j) {
-                            x_crows[i][j] = closed_interval_rand(0, 1) < 0.5;
+                            x_crows[i][j] = closed_interval_rand(generator, 0, 1) < 0.5;
                         }
                     }
                 }
             }
 
+            UFLP_LOG_DEBUG("Crow search evaluation cache: %llu hits, %llu misses (%.1f%% hit rate)",
+                           static_cast<unsigned long long>(cache.getHits()), static_cast<unsigned long long>(cache.getMisses()),
+                           100.0 * cache.getHitRate());
+
             return final_assignments;
         }
 
@@ -1,15 +1,14 @@
 #pragma once
 
 #include "Algorithm.hpp"
+#include <random>
 #include <vector>
 
 namespace algorithm {
 
     class CrowSearchAlgorithm : public Algorithm {
     private:
-        static double closed_interval_rand(double x0, double x1);
-        static double UFLP(int loc, int cus, const std::vector<std::vector<double>>& customer,
-                           const std::vector<double>& location, const std::vector<bool>& per);
+        static double closed_interval_rand(std::mt19937& generator, double x0, double x1);
 
         int population_size;
         double awareness_probability;
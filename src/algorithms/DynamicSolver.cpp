@@ -0,0 +1,49 @@
+#include "DynamicSolver.hpp"
+#include "Neighbourhood.hpp"
+#include "../misc/Logger.hpp"
+
+namespace algorithm {
+
+    DynamicSolver::DynamicSolver(const Problem& problem)
+        : problem(problem), evaluator(this->problem) {
+        evaluator.reset(std::vector<bool>(problem.getNumberOfWarehouses(), true));
+    }
+
+    void DynamicSolver::setSolution(const std::vector<bool>& open) {
+        evaluator.reset(open);
+    }
+
+    void DynamicSolver::setSolution(const std::vector<std::pair<int, int>>& assignments) {
+        std::vector<bool> open(problem.getNumberOfWarehouses(), false);
+        for (const auto& assignment : assignments) {
+            if (assignment.second >= 0) {
+                open[assignment.second] = true;
+            }
+        }
+        evaluator.reset(open);
+    }
+
+    int DynamicSolver::addCustomer(const Customer& customer) {
+        int j = problem.insertCustomer(Customer(customer));
+        evaluator.addCustomer(customer.getAllocationCosts());
+        return j;
+    }
+
+    void DynamicSolver::removeCustomer(int j) {
+        problem.removeCustomer(j);
+        evaluator.removeCustomer(j);
+    }
+
+    void DynamicSolver::setFixedCost(int i, double cost) {
+        problem.setFixedCost(i, cost);
+        evaluator.setFixedCost(i, cost);
+    }
+
+    int DynamicSolver::reoptimise() {
+        FlipNeighbourhood flip;
+        SwapNeighbourhood swap(evaluator);
+        int moves = variableNeighbourhoodDescent(evaluator, { &flip, &swap });
+        UFLP_LOG_DEBUG("Re-optimised in %d moves to %f", moves, evaluator.getCost());
+        return moves;
+    }
+}
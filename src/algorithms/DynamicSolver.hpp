@@ -0,0 +1,64 @@
+#pragma once
+#include "IncrementalEvaluator.hpp"
+#include <utility>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Keeps a solution of a changing problem and re-optimises it after every change.
+     *
+     * The solver owns a copy of the problem and an IncrementalEvaluator over it. Adding or
+     * removing a customer only computes that customer's nearest and second-nearest open
+     * facilities, and changing a fixed cost only adjusts the running total, so every change
+     * costs O(m). reoptimise() then runs the flip and swap descent from the current open set;
+     * after a small change it usually stops after a handful of moves.
+     *
+     * Customers can only be added to or removed from dense problems.
+     */
+    class DynamicSolver {
+    public:
+        /**
+         * @brief Starts with every facility open, like HillClimbingAlgorithm.
+         */
+        explicit DynamicSolver(const Problem& problem);
+
+        /**
+         * @brief Continues from the given open set, e.g. the result of another algorithm.
+         */
+        void setSolution(const std::vector<bool>& open);
+
+        /**
+         * @brief Continues from the facilities used by the given assignment.
+         */
+        void setSolution(const std::vector<std::pair<int, int>>& assignments);
+
+        /**
+         * @brief Adds a customer and returns its index.
+         */
+        int addCustomer(const Customer& customer);
+
+        /**
+         * @brief Removes customer j; the last customer takes index j.
+         */
+        void removeCustomer(int j);
+
+        void setFixedCost(int i, double cost);
+
+        /**
+         * @brief Runs the flip and swap descent from the current open set.
+         *
+         * @return The number of improving moves applied.
+         */
+        int reoptimise();
+
+        double getCost() const { return evaluator.getCost(); }
+        std::vector<bool> getOpenWarehouses() const { return evaluator.getOpenWarehouses(); }
+        std::vector<std::pair<int, int>> getAssignments() const { return evaluator.getAssignments(); }
+        const Problem& getProblem() const { return problem; }
+
+    private:
+        Problem problem;
+        IncrementalEvaluator evaluator;
+    };
+}
@@ -0,0 +1,67 @@
+#include "ElitePool.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace algorithm {
+
+    bool ElitePool::add(const std::vector<bool>& open, double cost) {
+        PackedBitset packed(static_cast<int>(open.size()));
+        for (std::size_t i = 0; i < open.size(); ++i) {
+            if (open[i]) {
+                packed.set(static_cast<int>(i));
+            }
+        }
+        return add(packed, cost);
+    }
+
+    bool ElitePool::add(const PackedBitset& open, double cost) {
+        if (!(cost < std::numeric_limits<double>::infinity())) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        int closest = -1;
+        int closest_distance = open.size() + 1;
+        for (int e = 0; e < static_cast<int>(entries.size()); ++e) {
+            int distance = entries[e].open.hammingDistance(open);
+            if (distance == 0) {
+                return false;
+            }
+            if (distance < closest_distance) {
+                closest_distance = distance;
+                closest = e;
+            }
+        }
+
+        if (closest != -1 && closest_distance < min_distance) {
+            // Too similar to an elite: it may only take that elite's place.
+            if (cost >= entries[closest].cost) {
+                return false;
+            }
+            entries[closest] = Entry{ open, cost };
+        }
+        else if (static_cast<int>(entries.size()) < capacity) {
+            entries.push_back(Entry{ open, cost });
+        }
+        else if (cost < entries.back().cost) {
+            entries.back() = Entry{ open, cost };
+        }
+        else {
+            return false;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.cost < b.cost; });
+        return true;
+    }
+
+    std::vector<ElitePool::Entry> ElitePool::getEntries() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries;
+    }
+
+    int ElitePool::size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<int>(entries.size());
+    }
+}
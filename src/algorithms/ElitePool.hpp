@@ -0,0 +1,46 @@
+#pragma once
+#include "PackedBitset.hpp"
+#include <mutex>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Thread-safe pool of the best mutually distinct solutions seen so far.
+     *
+     * A candidate lying at least min_distance flips (Hamming distance) from every elite is
+     * accepted while the pool has room, and afterwards replaces the worst elite if it beats
+     * it. A candidate closer than that to some elite can only replace that elite, and only if
+     * it is better, so the pool keeps its diversity. Any algorithm may feed the pool.
+     */
+    class ElitePool {
+    public:
+        struct Entry {
+            PackedBitset open;
+            double cost;
+        };
+
+        ElitePool(int capacity, int min_distance = 1)
+            : capacity(capacity), min_distance(min_distance) {}
+
+        /**
+         * @return True if the solution entered the pool.
+         */
+        bool add(const std::vector<bool>& open, double cost);
+        bool add(const PackedBitset& open, double cost);
+
+        /**
+         * @brief Copy of the elites sorted by increasing cost.
+         */
+        std::vector<Entry> getEntries() const;
+
+        int size() const;
+        int getCapacity() const { return capacity; }
+
+    private:
+        int capacity;
+        int min_distance;
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+    };
+}
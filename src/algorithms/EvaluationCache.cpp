@@ -0,0 +1,80 @@
+#include "EvaluationCache.hpp"
+#include <cstring>
+
+namespace algorithm {
+
+    namespace {
+        std::uint64_t toBits(double value) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        double fromBits(std::uint64_t bits) {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    }
+
+    EvaluationCache::EvaluationCache(int number_of_warehouses, std::size_t capacity)
+        : base(PackedBitset::mix(0x5EED)), keys(number_of_warehouses) {
+        std::size_t slots = 1;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        entries = std::vector<Entry>(slots);
+        mask = slots - 1;
+
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            keys[i] = PackedBitset::mix(base + static_cast<std::uint64_t>(i));
+        }
+    }
+
+    std::uint64_t EvaluationCache::hash(const std::vector<bool>& open) const {
+        std::uint64_t value = base;
+        for (std::size_t i = 0; i < open.size(); ++i) {
+            if (open[i]) {
+                value ^= keys[i];
+            }
+        }
+        return value;
+    }
+
+    std::uint64_t EvaluationCache::hash(const PackedBitset& open) const {
+        std::uint64_t value = base;
+        for (int w = 0; w < open.wordCount(); ++w) {
+            for (std::uint64_t bits = open.word(w); bits; bits &= bits - 1) {
+                value ^= keys[w * 64 + PackedBitset::popcount((bits & (~bits + 1)) - 1)];
+            }
+        }
+        return value;
+    }
+
+    bool EvaluationCache::lookup(std::uint64_t hash_value, double& cost) const {
+        const Entry& entry = entries[hash_value & mask];
+        std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+        std::uint64_t value = entry.value.load(std::memory_order_relaxed);
+
+        if ((check ^ value) == hash_value) {
+            cost = fromBits(value);
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void EvaluationCache::store(std::uint64_t hash_value, double cost) {
+        Entry& entry = entries[hash_value & mask];
+        std::uint64_t value = toBits(cost);
+        entry.check.store(hash_value ^ value, std::memory_order_relaxed);
+        entry.value.store(value, std::memory_order_relaxed);
+    }
+
+    double EvaluationCache::getHitRate() const {
+        std::uint64_t total = getHits() + getMisses();
+        return total == 0 ? 0.0 : static_cast<double>(getHits()) / static_cast<double>(total);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "PackedBitset.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Bounded, thread-safe memo of open-set costs keyed by a Zobrist hash.
+     *
+     * Every facility has a random 64-bit key and the hash of an open set is the XOR of the
+     * keys of its open facilities (plus a non-zero base), so flipping facility i changes the
+     * hash by keys[i] and a neighbour's hash costs one XOR.
+     *
+     * The table is direct-mapped and lock-free: each slot stores the cost bits and the hash
+     * XOR-ed with them, so a torn concurrent write simply reads back as a miss. New entries
+     * overwrite old ones, which bounds memory at the chosen capacity.
+     *
+     * A cache describes one problem instance; it must not be shared between different instances.
+     */
+    class EvaluationCache {
+    public:
+        /**
+         * @param number_of_warehouses Facilities in the instance (size of the Zobrist table).
+         * @param capacity Number of slots, rounded up to a power of two.
+         */
+        explicit EvaluationCache(int number_of_warehouses, std::size_t capacity = std::size_t(1) << 16);
+
+        std::uint64_t hash(const std::vector<bool>& open) const;
+        std::uint64_t hash(const PackedBitset& open) const;
+
+        std::uint64_t flipHash(std::uint64_t hash_value, int i) const {
+            return hash_value ^ keys[i];
+        }
+
+        /**
+         * @brief Looks the hash up and counts a hit or a miss.
+         */
+        bool lookup(std::uint64_t hash_value, double& cost) const;
+        void store(std::uint64_t hash_value, double cost);
+
+        std::uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+        std::uint64_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+        double getHitRate() const;
+        std::size_t getCapacity() const { return entries.size(); }
+
+    private:
+        struct Entry {
+            std::atomic<std::uint64_t> check{ 0 };
+            std::atomic<std::uint64_t> value{ 0 };
+        };
+
+        std::uint64_t base;
+        std::vector<std::uint64_t> keys;
+        std::vector<Entry> entries;
+        std::size_t mask;
+        mutable std::atomic<std::uint64_t> hits{ 0 };
+        mutable std::atomic<std::uint64_t> misses{ 0 };
+    };
+}
@@ -1,10 +1,15 @@
 #include "GRASP.hpp"
+#include "ElitePool.hpp"
+#include "Neighbourhood.hpp"
+#include "PathRelinking.hpp"
+#include "../misc/Logger.hpp"
 #include <cstdlib>
 #include <ctime>
-#include <iostream>
 #include <unordered_map>
 #include <algorithm>
-#include <thread>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 namespace algorithm
@@ -12,12 +17,52 @@ namespace algorithm
     /**
      * @brief Constructor for the GRASP class.
      *
-     * @param num_iterations Number of iterations for the GRASP algorithm.
-     * @param num_iterations_local Number of iterations for the local search heuristic.
      * @param alpha Parameter for the greedy randomized constructive phase.
+     * @param iterations Number of construction and local search iterations (multi-start).
+     * @param elite_pool_size Number of elite local optima kept for path relinking; 0 disables relinking.
      */
-    GRASP::GRASP(double alpha)
-        : alpha(alpha) {}
+    GRASP::GRASP(double alpha, int iterations, int elite_pool_size)
+        : alpha(alpha), iterations(iterations), elite_pool_size(elite_pool_size), stop_flag(nullptr), problem(nullptr), seed(0),
+          update_period(1), amplification(0.0) {}
+
+    /**
+     * @brief Constructor for Reactive GRASP.
+     *
+     * @param alphas Values alpha is drawn from; must not be empty.
+     * @param iterations Number of construction and local search iterations (multi-start).
+     * @param elite_pool_size Number of elite local optima kept for path relinking; 0 disables relinking.
+     * @param update_period Iterations between updates of the draw probabilities.
+     * @param amplification Exponent that sharpens the preference for the better alpha values.
+     */
+    GRASP::GRASP(const std::vector<double>& alphas, int iterations, int elite_pool_size, int update_period, double amplification)
+        : alpha(alphas.empty() ? 0.0 : alphas.front()), iterations(iterations), elite_pool_size(elite_pool_size), stop_flag(nullptr), problem(nullptr), seed(0),
+          reactive_alphas(alphas), update_period(std::max(1, update_period)), amplification(amplification) {
+        if (alphas.empty()){
+            throw std::invalid_argument("Reactive GRASP needs at least one alpha");
+        }
+    }
+
+    std::vector<double> GRASP::defaultReactiveAlphas(){
+        std::vector<double> alphas;
+        for (int k = 0; k <= 10; ++k){
+            alphas.push_back(k / 10.0);
+        }
+        return alphas;
+    }
+
+    /**
+     * @brief Draws the index of a reactive alpha with the current probabilities.
+     */
+    int GRASP::drawAlpha(){
+        double draw = alpha_generator() / 4294967296.0;
+        for (std::size_t k = 0; k + 1 < alpha_probabilities.size(); ++k){
+            draw -= alpha_probabilities[k];
+            if (draw < 0.0){
+                return static_cast<int>(k);
+            }
+        }
+        return static_cast<int>(alpha_probabilities.size()) - 1;
+    }
 
     /**
      * @brief Initializes the GRASP algorithm with the given problem.
@@ -25,24 +70,21 @@ namespace algorithm
      * @param problem The problem instance to solve.
      *
      * This function initializes various parameters and data structures required for the GRASP algorithm,
-     * including the number of customers, the number of warehouses, fixed costs, allocation costs, and assignment vectors.
+     * including the number of customers, the number of warehouses, fixed costs, and assignment vectors.
+     * Allocation costs are read from the problem itself, so a sparse problem is never expanded to n x m.
      */
     void GRASP::initialize(const Problem &problem){
         number_of_customers = problem.getNumberOfCustomers();
         number_of_warehouses = problem.getNumberOfWarehouses();
 
         fixed_costs.resize(number_of_warehouses);
-        allocation_costs.resize(number_of_warehouses, std::vector<double>(number_of_customers));
 
         for (int i = 0; i < number_of_warehouses; ++i){
             fixed_costs[i] = problem.getWarehouses()[i].getFixedCost();
         }
 
-        for (int j = 0; j < number_of_customers; ++j){
-            for (int i = 0; i < number_of_warehouses; ++i){
-                allocation_costs[i][j] = problem.getCustomers()[j].getAllocationCosts()[i];
-            }
-        }
+        this->problem = &problem;
+        evaluator.reset(new IncrementalEvaluator(problem));
 
         best_assignment.resize(number_of_customers);
         warehouse_open.resize(number_of_warehouses, false);
@@ -52,28 +94,14 @@ namespace algorithm
     /**
      * @brief Reassigns customers to the currently open warehouses to minimize costs.
      *
-     * @return The total cost of the current assignment.
+     * @return The total cost of the current assignment, or MAX_DOUBLE if some customer has no open warehouse it can use.
      *
-     * This function calculates the minimum cost assignment of customers to open warehouses.
-     * It updates the customer assignment and calculates the total cost considering both fixed and allocation costs.
+     * This function assigns every customer to its nearest open warehouse with Problem::assignToNearest, which
+     * walks only the stored row of a sparse problem. It updates the customer assignment and calculates the
+     * total cost considering both fixed and allocation costs.
      */
     double GRASP::ReassignCustomers(){
-        std::vector<double> customer_min_cost(number_of_customers, MAX_DOUBLE);
-        std::vector<int> best_assignment_temp(number_of_customers, -1);
-
-        for (int j = 0; j < number_of_customers; ++j){
-            double assign_cost = MAX_DOUBLE;
-            int best_warehouse = -1;
-
-            for (int i = 0; i < number_of_warehouses; ++i){
-                if (warehouse_open[i] && allocation_costs[i][j] < assign_cost){
-                    assign_cost = allocation_costs[i][j];
-                    best_warehouse = i;
-                }
-            }
-            customer_min_cost[j] = assign_cost;
-            best_assignment_temp[j] = best_warehouse;
-        }
+        std::vector<std::pair<int, int>> assignments = problem->assignToNearest(warehouse_open);
 
         double cost = 0;
 
@@ -83,125 +111,18 @@ namespace algorithm
             }
         }
 
-        for (int j = 0; j < number_of_customers; ++j){
-            if (best_assignment_temp[j] != -1){
-                cost += customer_min_cost[j];
-                customer_assignment[j] = best_assignment_temp[j];
+        bool unserved = false;
+        for (const auto &assignment : assignments){
+            if (assignment.second != -1){
+                cost += problem->getAllocationCost(assignment.first, assignment.second);
+                customer_assignment[assignment.first] = assignment.second;
             }
-        }
-
-        return cost;
-    }
-
-    /**
-     * @brief Attempts to close one of the currently open warehouses to reduce costs.
-     *
-     * @return True if a warehouse was successfully closed to reduce costs, false otherwise.
-     *
-     * This function iterates over all open warehouses and attempts to close each one,
-     * reassigning customers to minimize costs. If closing a warehouse reduces the total cost,
-     * the function keeps it closed.
-     */
-    bool GRASP::CloseWarehouse(){
-        int best_warehouse = -1;
-
-        for (int i = 0; i < number_of_warehouses; ++i){
-            if (warehouse_open[i]){
-                warehouse_open[i] = false;
-                double cost = ReassignCustomers();
-
-                if (cost < current_objective){
-                    current_objective = cost;
-                    best_warehouse = i;
-                }
-
-                warehouse_open[i] = true;
-            }
-        }
-
-        if (best_warehouse != -1){
-            warehouse_open[best_warehouse] = false;
-            return true;
-        }
-
-        return false;
-    }
-
-    /**
-     * @brief Attempts to open one of the currently closed warehouses to reduce costs.
-     *
-     * @return True if a warehouse was successfully opened to reduce costs, false otherwise.
-     *
-     * This function iterates over all closed warehouses and attempts to open each one,
-     * reassigning customers to minimize costs. If opening a warehouse reduces the total cost,
-     * the function keeps it open.
-     */
-    bool GRASP::OpenWarehouse(){
-        int best_warehouse = -1;
-
-        for (int i = 0; i < number_of_warehouses; ++i){
-            if (!warehouse_open[i]){
-                warehouse_open[i] = true;
-                double cost = ReassignCustomers();
-
-                if (cost < current_objective){
-                    current_objective = cost;
-                    best_warehouse = i;
-                }
-
-                warehouse_open[i] = false;
-            }
-        }
-
-        if (best_warehouse != -1){
-            warehouse_open[best_warehouse] = true;
-            return true;
-        }
-
-        return false;
-    }
-
-    /**
-     * @brief Attempts to simultaneously open one closed warehouse and close one open warehouse to reduce costs.
-     *
-     * @return True if a pair of warehouses was successfully opened and closed to reduce costs, false otherwise.
-     *
-     * This function iterates over all pairs of open and closed warehouses, attempting to open a closed warehouse
-     * and close an open warehouse simultaneously. If this operation reduces the total cost, the function keeps the
-     * changes.
-     */
-    bool GRASP::OpenCloseWarehouse(){
-        int best_open = -1;
-        int best_closed = -1;
-
-        for (int i1 = 0; i1 < number_of_warehouses; ++i1){
-            if (!warehouse_open[i1]){
-                for (int i2 = 0; i2 < number_of_warehouses; ++i2){
-                    if (warehouse_open[i2]){
-                        warehouse_open[i1] = true;
-                        warehouse_open[i2] = false;
-                        double cost = ReassignCustomers();
-
-                        if (cost < current_objective){
-                            current_objective = cost;
-                            best_open = i1;
-                            best_closed = i2;
-                        }
-
-                        warehouse_open[i1] = false;
-                        warehouse_open[i2] = true;
-                    }
-                }
+            else {
+                unserved = true;
             }
         }
 
-        if (best_open != -1 && best_closed != -1){
-            warehouse_open[best_open] = true;
-            warehouse_open[best_closed] = false;
-            return true;
-        }
-
-        return false;
+        return unserved ? MAX_DOUBLE : cost;
     }
 
     /**
@@ -210,35 +131,18 @@ namespace algorithm
      * @param objective The current objective cost.
      * @return The optimized objective cost after local search.
      *
-     * This function applies a local search heuristic, iteratively attempting to open, close, and
-     * open-close warehouses to reduce the objective cost. The search stops if no improvement is found
-     * or the maximum number of local iterations is reached.
+     * This function runs a variable neighbourhood descent over the close/open (flip) and
+     * open-close (swap) neighbourhoods of the shared neighbourhood library, priced incrementally,
+     * until no move reduces the objective cost.
      */
     double GRASP::LocalSearchHeuristic(double objective){
         current_objective = objective;
-        bool improved = true;
-        int iterations = 0;
-
-        while (improved){
-            improved = false;
-
-            if (CloseWarehouse()){
-                improved = true;
-                current_objective = ReassignCustomers();
-            }
-
-            if (!improved && OpenWarehouse()){
-                improved = true;
-                current_objective = ReassignCustomers();
-            }
 
-            if (!improved && OpenCloseWarehouse()){
-                improved = true;
-                current_objective = ReassignCustomers();
-            }
-
-            iterations++;
-        }
+        evaluator->reset(warehouse_open);
+        FlipNeighbourhood flip;
+        SwapNeighbourhood swap(*evaluator);
+        variableNeighbourhoodDescent(*evaluator, { &flip, &swap });
+        warehouse_open = evaluator->getOpenWarehouses();
 
         current_objective = ReassignCustomers();
 
@@ -252,70 +156,215 @@ namespace algorithm
      *
      * This function performs the greedy randomized constructive phase of the GRASP algorithm.
      * It iteratively opens warehouses based on a restricted candidate list determined by the parameter alpha,
-     * then applies local search to optimize the solution.
+     * then applies local search to optimize the solution. In reactive mode it stops opening once no closed
+     * warehouse would lower the cost.
+     *
+     * The cost of opening every closed warehouse is kept incrementally instead of being recomputed with
+     * ReassignCustomers: for each candidate, the saving it would bring to the served customers and the
+     * customers it would serve for the first time. Opening a warehouse only revisits the customers it
+     * takes over, and for each of them only the candidates cheaper than its previous nearest open
+     * warehouse (the others' savings on it do not change). Candidates sit in two lazy heaps, cheapest and
+     * dearest cost first; an updated candidate is pushed again and its outdated entries are skipped when
+     * they reach the top. A step therefore costs O(affected customers * candidates touched + RCL log m)
+     * instead of O(m * n * m).
      */
     double GRASP::GreedyRandomizedConstructive(){
-        double best_cost = MAX_DOUBLE;
-
         std::fill(warehouse_open.begin(), warehouse_open.end(), false);
         std::fill(best_assignment.begin(), best_assignment.end(), -1);
 
-        while (true){
-            int best_warehouse = -1;
-            double imp_cost = best_cost;
-            std::vector<int> restricted_candidate_list;
-            double min_cost = MAX_DOUBLE;
-            double max_cost = -MAX_DOUBLE;
-            std::vector<double> costs(number_of_warehouses, MAX_DOUBLE);
-            std::vector<bool> is_open(number_of_warehouses, false);
-            std::vector<std::thread> threads;
+        const double infinity = std::numeric_limits<double>::infinity();
+        std::shared_ptr<const SparseCosts> sparse = problem->getSparseCosts();
+        std::shared_ptr<const FacilityOrder> order = problem->getFacilityOrder();
 
-            for (int i = 0; i < number_of_warehouses; ++i){
-                if (!warehouse_open[i]){
-                    threads.push_back(std::thread([&, i]{
-                        warehouse_open[i] = true;
-                        double cost = ReassignCustomers();
-                        warehouse_open[i] = false;
-                        costs[i] = cost;
-                        is_open[i] = true; 
-                        }));
+        std::vector<double> nearest(number_of_customers, infinity); // Cost of the nearest open warehouse
+        std::vector<double> saving(number_of_warehouses, 0.0);      // On customers already served
+        std::vector<double> new_cost(number_of_warehouses, 0.0);    // Of the customers it would serve first
+        std::vector<int> new_customers(number_of_warehouses, 0);
+        for (int j = 0; j < number_of_customers; ++j){
+            if (sparse){
+                for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j); ++e){
+                    new_cost[sparse->getFacility(e)] += sparse->getCost(e);
+                    ++new_customers[sparse->getFacility(e)];
                 }
             }
-
-            for (auto &th : threads){
-                if (th.joinable()){
-                    th.join();
+            else {
+                const std::vector<double> &row = problem->getCustomers()[j].getAllocationCosts();
+                for (int i = 0; i < number_of_warehouses; ++i){
+                    new_cost[i] += row[i];
+                    ++new_customers[i];
                 }
             }
+        }
 
+        int unserved = number_of_customers;
+        double open_cost = 0.0; // Fixed costs of the open warehouses plus the allocation cost of the served customers
+
+        auto costOfOpening = [&](int i){
+            return unserved - new_customers[i] > 0 ? MAX_DOUBLE : open_cost + fixed_costs[i] - saving[i] + new_cost[i];
+        };
+
+        struct Entry {
+            double cost;
+            int warehouse;
+            int version;
+        };
+        auto cheaper = [](const Entry &a, const Entry &b){ return a.cost > b.cost || (a.cost == b.cost && a.warehouse > b.warehouse); };
+        auto dearer = [](const Entry &a, const Entry &b){ return a.cost < b.cost || (a.cost == b.cost && a.warehouse < b.warehouse); };
+        std::vector<Entry> cheapest, dearest;
+        std::vector<int> version(number_of_warehouses, 0);
+
+        auto rebuild = [&](){
+            cheapest.clear();
+            dearest.clear();
             for (int i = 0; i < number_of_warehouses; ++i){
-                if (is_open[i]){
-                    if (costs[i] < min_cost)
-                        min_cost = costs[i];
-                    if (costs[i] > max_cost)
-                        max_cost = costs[i];
+                if (!warehouse_open[i]){
+                    cheapest.push_back({ costOfOpening(i), i, version[i] });
                 }
             }
+            dearest = cheapest;
+            std::make_heap(cheapest.begin(), cheapest.end(), cheaper);
+            std::make_heap(dearest.begin(), dearest.end(), dearer);
+        };
+        auto isCurrent = [&](const Entry &entry){
+            return !warehouse_open[entry.warehouse] && entry.version == version[entry.warehouse];
+        };
+        auto dropOutdated = [&](std::vector<Entry> &heap, const auto &compare){
+            while (!heap.empty() && !isCurrent(heap.front())){
+                std::pop_heap(heap.begin(), heap.end(), compare);
+                heap.pop_back();
+            }
+        };
+        rebuild();
 
-            double threshold = min_cost + alpha * (max_cost - min_cost);
+        std::vector<int> touched;
+        std::vector<int> touched_stamp(number_of_warehouses, -1);
+        int step = 0;
 
-            for (int i = 0; i < number_of_warehouses; ++i){
-                if (is_open[i] && costs[i] <= threshold){
-                    restricted_candidate_list.push_back(i);
+        // Customer j moves from old_cost (infinite if unserved) to new_cost_j; update the candidates cheaper than old_cost
+        auto updateCandidate = [&](int i, double candidate_cost, double old_cost, double nearest_cost){
+            if (warehouse_open[i]){
+                return;
+            }
+            if (old_cost == infinity){
+                new_cost[i] -= candidate_cost;
+                --new_customers[i];
+                saving[i] += std::max(0.0, nearest_cost - candidate_cost);
+            }
+            else {
+                saving[i] -= (old_cost - candidate_cost) - std::max(0.0, nearest_cost - candidate_cost);
+            }
+            if (touched_stamp[i] != step){
+                touched_stamp[i] = step;
+                touched.push_back(i);
+            }
+        };
+        auto moveCustomer = [&](int j, double nearest_cost){
+            double old_cost = nearest[j];
+            if (sparse){
+                for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j) && sparse->getCost(e) < old_cost; ++e){
+                    updateCandidate(sparse->getFacility(e), sparse->getCost(e), old_cost, nearest_cost);
+                }
+            }
+            else if (order){
+                const std::vector<double> &row = problem->getCustomers()[j].getAllocationCosts();
+                for (int rank = 0; rank < number_of_warehouses && row[order->at(j, rank)] < old_cost; ++rank){
+                    updateCandidate(order->at(j, rank), row[order->at(j, rank)], old_cost, nearest_cost);
+                }
+            }
+            else {
+                const std::vector<double> &row = problem->getCustomers()[j].getAllocationCosts();
+                for (int i = 0; i < number_of_warehouses; ++i){
+                    if (row[i] < old_cost){
+                        updateCandidate(i, row[i], old_cost, nearest_cost);
+                    }
                 }
             }
 
-            if (restricted_candidate_list.empty())
+            if (old_cost == infinity){
+                --unserved;
+                open_cost += nearest_cost;
+            }
+            else {
+                open_cost += nearest_cost - old_cost;
+            }
+            nearest[j] = nearest_cost;
+        };
+
+        std::vector<Entry> restricted_candidate_list;
+        while (true){
+            dropOutdated(cheapest, cheaper);
+            dropOutdated(dearest, dearer);
+            if (cheapest.empty())
                 break;
 
-            int chosen_index = rand() % restricted_candidate_list.size();
-            best_warehouse = restricted_candidate_list[chosen_index];
-            warehouse_open[best_warehouse] = true;
-            best_cost = ReassignCustomers();
+            double min_cost = cheapest.front().cost;
+            double max_cost = dearest.front().cost;
 
-            for (int j = 0; j < number_of_customers; ++j){
-                best_assignment[j] = customer_assignment[j];
+            // In reactive mode, stop once no closed warehouse improves a feasible solution (until
+            // every customer can be served, keep opening); otherwise alpha would not matter, as the
+            // construction would end with every warehouse open
+            double current_cost = unserved > 0 ? MAX_DOUBLE : open_cost;
+            if (!reactive_alphas.empty() && current_cost < MAX_DOUBLE && min_cost >= current_cost)
+                break;
+
+            double threshold = min_cost + alpha * (max_cost - min_cost);
+
+            restricted_candidate_list.clear();
+            while (!cheapest.empty() && cheapest.front().cost <= threshold){
+                restricted_candidate_list.push_back(cheapest.front());
+                std::pop_heap(cheapest.begin(), cheapest.end(), cheaper);
+                cheapest.pop_back();
+                dropOutdated(cheapest, cheaper);
             }
+            std::sort(restricted_candidate_list.begin(), restricted_candidate_list.end(),
+                      [](const Entry &a, const Entry &b){ return a.warehouse < b.warehouse; });
+
+            int chosen_index = static_cast<int>(generator() % restricted_candidate_list.size());
+            int chosen = restricted_candidate_list[chosen_index].warehouse;
+            for (const Entry &entry : restricted_candidate_list){
+                if (entry.warehouse != chosen){
+                    cheapest.push_back(entry);
+                    std::push_heap(cheapest.begin(), cheapest.end(), cheaper);
+                }
+            }
+
+            // Open it and move the customers it serves more cheaply
+            ++step;
+            touched.clear();
+            warehouse_open[chosen] = true;
+            open_cost += fixed_costs[chosen];
+            if (sparse){
+                for (std::size_t e = sparse->columnBegin(chosen); e < sparse->columnEnd(chosen); ++e){
+                    if (sparse->getColumnCost(e) < nearest[sparse->getColumnCustomer(e)]){
+                        moveCustomer(sparse->getColumnCustomer(e), sparse->getColumnCost(e));
+                    }
+                }
+            }
+            else {
+                for (int j = 0; j < number_of_customers; ++j){
+                    double cost = problem->getCustomers()[j].getAllocationCosts()[chosen];
+                    if (cost < nearest[j]){
+                        moveCustomer(j, cost);
+                    }
+                }
+            }
+
+            for (int i : touched){
+                ++version[i];
+                Entry entry = { costOfOpening(i), i, version[i] };
+                cheapest.push_back(entry);
+                std::push_heap(cheapest.begin(), cheapest.end(), cheaper);
+                dearest.push_back(entry);
+                std::push_heap(dearest.begin(), dearest.end(), dearer);
+            }
+            if (cheapest.size() + dearest.size() > 8 * static_cast<std::size_t>(number_of_warehouses) + 64){
+                rebuild();
+            }
+        }
+
+        double best_cost = ReassignCustomers();
+        for (int j = 0; j < number_of_customers; ++j){
+            best_assignment[j] = customer_assignment[j];
         }
 
         return best_cost;
@@ -328,28 +377,93 @@ namespace algorithm
      * @return A vector of pairs representing the assignment of customers to warehouses.
      *
      * This function performs the GRASP algorithm over multiple iterations, each time constructing
-     * a greedy randomized solution and applying local search to optimize it. The best solution found
-     * across all iterations is returned as a vector of customer-to-warehouse assignments.
+     * a greedy randomized solution and applying local search to optimize it. The local optima are
+     * kept in an elite pool and, once all iterations are done, path relinking between the elites
+     * is run as a post-optimisation stage. The best solution found is returned as a vector of
+     * customer-to-warehouse assignments. With a warm start, the first iteration runs its local
+     * search from the warm-start open set instead of a constructed one. In reactive mode every
+     * constructed iteration draws its alpha, and the draw probabilities are updated from the mean
+     * local optimum cost each alpha has produced.
      */
     std::vector<std::pair<int, int>> GRASP::solve(const Problem &problem){
         initialize(problem);
 
+        ElitePool pool(std::max(elite_pool_size, 1), 2);
         double best_cost = MAX_DOUBLE;
-        double cost = GreedyRandomizedConstructive();
-        cost = LocalSearchHeuristic(cost);
 
-        if (cost < best_cost){
-            best_cost = cost;
+        std::vector<bool> start = getInitialOpenSet(problem);
+
+        const bool reactive = !reactive_alphas.empty();
+        std::vector<double> alpha_cost_sums(reactive_alphas.size(), 0.0);
+        std::vector<int> alpha_counts(reactive_alphas.size(), 0);
+        alpha_probabilities.assign(reactive_alphas.size(), 1.0 / std::max<std::size_t>(1, reactive_alphas.size()));
+        seedEngine(alpha_generator, deriveSeed(seed, 0));
+
+        for (int iteration = 0; iteration < iterations; ++iteration){
+            // The first iteration always runs, so there is a solution to return
+            if (iteration > 0 && stop_flag != nullptr && stop_flag->load(std::memory_order_relaxed)){
+                break;
+            }
+
+            double cost;
+            int drawn = -1;
+            if (iteration == 0 && !start.empty()){
+                warehouse_open = start;
+                cost = ReassignCustomers();
+            }
+            else {
+                if (reactive){
+                    drawn = drawAlpha();
+                    alpha = reactive_alphas[drawn];
+                }
+                // Each restart has its own stream, so it does not depend on the draws of the previous ones
+                seedEngine(generator, deriveSeed(seed, iteration + 1));
+                cost = GreedyRandomizedConstructive();
+            }
+            cost = LocalSearchHeuristic(cost);
+            UFLP_LOG_DEBUG("GRASP iteration %d: alpha %g, local optimum %f", iteration, alpha, cost);
+
+            if (drawn >= 0 && cost < MAX_DOUBLE){
+                alpha_cost_sums[drawn] += cost;
+                ++alpha_counts[drawn];
+            }
+
+            if (elite_pool_size > 0){
+                pool.add(warehouse_open, cost);
+            }
+
+            if (cost < best_cost){
+                best_cost = cost;
+                best_warehouse_open = warehouse_open;
+            }
 
-            for (int j = 0; j < number_of_customers; ++j){
-                best_assignment[j] = customer_assignment[j];
+            if (reactive && (iteration + 1) % update_period == 0 && best_cost < MAX_DOUBLE){
+                double total = 0.0;
+                for (std::size_t k = 0; k < reactive_alphas.size(); ++k){
+                    double ratio = alpha_counts[k] > 0 ? best_cost / (alpha_cost_sums[k] / alpha_counts[k]) : 1.0;
+                    alpha_probabilities[k] = std::pow(ratio, amplification);
+                    total += alpha_probabilities[k];
+                }
+                for (double &probability : alpha_probabilities){
+                    probability /= total;
+                }
+            }
+        }
+
+        if (elite_pool_size > 1 && pool.size() > 1){
+            ElitePool::Entry relinked = PathRelinking().run(problem, pool);
+
+            if (relinked.cost < best_cost){
+                best_cost = relinked.cost;
+                best_warehouse_open = relinked.open.toVector();
             }
         }
 
         warehouse_open = best_warehouse_open;
+        ReassignCustomers();
 
         for (int j = 0; j < number_of_customers; ++j){
-            customer_assignment[j] = best_assignment[j];
+            best_assignment[j] = customer_assignment[j];
         }
 
         std::vector<std::pair<int, int>> result;
@@ -360,4 +474,26 @@ namespace algorithm
 
         return result;
     }
+
+    std::vector<std::pair<int, int>> GRASPAlgorithm::solve(const Problem &problem) const {
+        GRASP grasp = reactive_alphas.empty() ? GRASP(alpha, iterations, elite_pool_size) : GRASP(reactive_alphas, iterations, elite_pool_size);
+        grasp.shareStopFlag(stop_flag);
+        grasp.setSeed(master_seed);
+        std::vector<bool> start = getInitialOpenSet(problem);
+        if (!start.empty()){
+            grasp.setInitialSolution(start);
+        }
+
+        std::vector<std::pair<int, int>> result = grasp.solve(problem);
+        if (incumbent != nullptr){
+            std::vector<bool> open(problem.getNumberOfWarehouses(), false);
+            for (const auto &assignment : result){
+                if (assignment.second >= 0){
+                    open[assignment.second] = true;
+                }
+            }
+            offerIncumbent(problem.evaluate(result), open);
+        }
+        return result;
+    }
 }
@@ -1,13 +1,18 @@
 #pragma once
 #include "../problem/Problem.hpp"
+#include "Algorithm.hpp"
+#include "IncrementalEvaluator.hpp"
+#include <atomic>
+#include <cstdint>
+#include <random>
 #include <vector>
 #include <limits>
+#include <memory>
 
 namespace algorithm {
 
-    class GRASP {
+    class GRASP : public WarmStart {
     private:
-        std::vector<std::vector<double>> allocation_costs;
         std::vector<double> fixed_costs;
         double current_objective;
         std::vector<int> best_assignment;
@@ -18,17 +23,93 @@ namespace algorithm {
         std::vector<int> customer_assignment;
         std::vector<bool> best_warehouse_open;
         double alpha;
+        int iterations;
+        int elite_pool_size;
+        const std::atomic<bool>* stop_flag;
+        std::unique_ptr<IncrementalEvaluator> evaluator;
+        const Problem* problem;
+
+        // Iteration k constructs with stream k + 1 of the seed; reactive alphas are drawn from stream 0
+        std::uint64_t seed;
+        std::mt19937 generator;
+        std::mt19937 alpha_generator;
+
+        // Reactive mode: alpha is drawn from reactive_alphas with alpha_probabilities
+        std::vector<double> reactive_alphas;
+        std::vector<double> alpha_probabilities;
+        int update_period;
+        double amplification;
 
-        bool CloseWarehouse();
-        bool OpenWarehouse();
-        bool OpenCloseWarehouse();
         double LocalSearchHeuristic(double objective);
         double GreedyRandomizedConstructive();
         double ReassignCustomers();
+        int drawAlpha();
 
     public:
-        GRASP(double alpha);
+        GRASP(double alpha, int iterations = 1, int elite_pool_size = 0);
+
+        /**
+         * @brief Reactive GRASP: every iteration draws alpha from the given values.
+         *
+         * The draw probabilities start uniform and every update_period iterations become
+         * proportional to (best cost / mean local optimum cost of the value)^amplification, so the
+         * values that have produced good solutions are drawn more often. A value not drawn yet
+         * gets the largest weight, so every value is tried. The construction stops once no
+         * closed warehouse lowers the cost, instead of opening every warehouse.
+         */
+        GRASP(const std::vector<double>& alphas, int iterations, int elite_pool_size = 0, int update_period = 5, double amplification = 10.0);
+
+        /**
+         * @brief The draw probability of every reactive alpha after the last solve; empty if not reactive.
+         */
+        const std::vector<double>& getAlphaProbabilities() const {
+            return alpha_probabilities;
+        }
+
+        /**
+         * @brief 0, 0.1, ..., 1: the usual alpha set of Reactive GRASP.
+         */
+        static std::vector<double> defaultReactiveAlphas();
         void initialize(const Problem& problem);
+
+        /**
+         * @brief Master seed of later solves; 0 by default.
+         */
+        void setSeed(std::uint64_t seed) {
+            this->seed = seed;
+        }
+
         std::vector<std::pair<int, int>> solve(const Problem& problem);
+
+        /**
+         * @brief Flag checked between iterations; once it is set, the solve returns the best solution found so far.
+         */
+        void shareStopFlag(const std::atomic<bool>* flag) {
+            stop_flag = flag;
+        }
+    };
+
+    /**
+     * @brief GRASP behind the Algorithm interface. Every solve runs a fresh GRASP with the
+     * stored parameters, so the object can be shared like the other algorithms.
+     */
+    class GRASPAlgorithm : public Algorithm {
+    public:
+        GRASPAlgorithm(double alpha, int iterations = 1, int elite_pool_size = 0)
+            : alpha(alpha), iterations(iterations), elite_pool_size(elite_pool_size) {}
+
+        /**
+         * @brief Reactive GRASP over the given alpha values.
+         */
+        GRASPAlgorithm(const std::vector<double>& alphas, int iterations, int elite_pool_size = 0)
+            : alpha(0.0), iterations(iterations), elite_pool_size(elite_pool_size), reactive_alphas(alphas) {}
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+    private:
+        double alpha;
+        int iterations;
+        int elite_pool_size;
+        std::vector<double> reactive_alphas;
     };
 }
@@ -0,0 +1,250 @@
+#include "GeneticAlgorithm.hpp"
+#include "ElitePool.hpp"
+#include "EvaluationCache.hpp"
+#include "IncrementalEvaluator.hpp"
+#include "Neighbourhood.hpp"
+#include "PackedBitset.hpp"
+#include "../misc/Logger.hpp"
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace algorithm {
+
+    namespace {
+        const double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+        struct Individual {
+            PackedBitset genes;
+            double fitness;
+        };
+
+        /**
+         * @brief Scores a batch of individuals with one tiled sweep of the search costs
+         * (CostMatrix::evaluateBatch). An individual with nothing open, or leaving a customer
+         * of a sparse problem unserved, is infinite.
+         */
+        void evaluateBatch(const CostMatrix& costs, const std::vector<const PackedBitset*>& batch, std::vector<double>& fitness) {
+            std::vector<std::vector<bool>> open_sets;
+            open_sets.reserve(batch.size());
+            std::vector<const std::vector<bool>*> pointers;
+            for (const PackedBitset* genes : batch) {
+                open_sets.push_back(genes->toVector());
+                pointers.push_back(&open_sets.back());
+            }
+
+            costs.evaluateBatch(pointers, fitness);
+            for (double& value : fitness) {
+                if (value == std::numeric_limits<double>::max()) {
+                    value = INFINITE_COST;
+                }
+            }
+        }
+
+        PackedBitset uniformCrossover(const PackedBitset& a, const PackedBitset& b, std::mt19937_64& generator) {
+            PackedBitset child = a;
+            for (int w = 0; w < child.wordCount(); ++w) {
+                std::uint64_t mask = generator();
+                child.word(w) = ((a.word(w) & mask) | (b.word(w) & ~mask)) & a.wordMask(w);
+            }
+            return child;
+        }
+
+        /**
+         * @brief Walks from a towards b, importing b's bits one word at a time in random order,
+         * and returns the best strict intermediate (or a itself if the parents differ in one word or less).
+         */
+        PackedBitset pathRelinkingCrossover(IncrementalEvaluator& evaluator, const PackedBitset& a, const PackedBitset& b,
+                                            std::mt19937_64& generator) {
+            std::vector<int> differing;
+            for (int w = 0; w < a.wordCount(); ++w) {
+                if (a.word(w) != b.word(w)) {
+                    differing.push_back(w);
+                }
+            }
+            if (differing.size() < 2) {
+                return a;
+            }
+            std::shuffle(differing.begin(), differing.end(), generator);
+
+            evaluator.reset(a.toVector());
+            PackedBitset current = a;
+            PackedBitset best;
+            double best_cost = INFINITE_COST;
+
+            for (std::size_t step = 0; step + 1 < differing.size(); ++step) {
+                int w = differing[step];
+                std::uint64_t difference = a.word(w) ^ b.word(w);
+
+                // Open before closing so the set never becomes empty.
+                for (std::uint64_t bits = difference & b.word(w); bits; bits &= bits - 1) {
+                    evaluator.flip(w * 64 + PackedBitset::popcount((bits & (~bits + 1)) - 1));
+                }
+                for (std::uint64_t bits = difference & a.word(w); bits; bits &= bits - 1) {
+                    int i = w * 64 + PackedBitset::popcount((bits & (~bits + 1)) - 1);
+                    if (evaluator.getOpenCount() > 1) {
+                        evaluator.flip(i);
+                    }
+                }
+                for (int i = w * 64; i < std::min(current.size(), w * 64 + 64); ++i) {
+                    if (evaluator.isOpen(i)) current.set(i); else current.reset(i);
+                }
+
+                if (evaluator.getCost() < best_cost) {
+                    best_cost = evaluator.getCost();
+                    best = current;
+                }
+            }
+
+            return best;
+        }
+
+        void mutate(PackedBitset& genes, double rate, std::mt19937_64& generator) {
+            std::geometric_distribution<int> gap(rate);
+            for (int i = gap(generator); i < genes.size(); i += 1 + gap(generator)) {
+                genes.flip(i);
+            }
+            if (genes.count() == 0) {
+                genes.set(std::uniform_int_distribution<int>(0, genes.size() - 1)(generator));
+            }
+        }
+    }
+
+    /**
+     * @brief Solves the problem with the memetic genetic algorithm.
+     *
+     * @param problem The problem instance to solve.
+     * @return A vector of pairs representing the assignment of customers to warehouses.
+     */
+    std::vector<std::pair<int, int>> GeneticAlgorithm::solve(const Problem& problem) const {
+        const int m = problem.getNumberOfWarehouses();
+        const double mutation_rate = 1.0 / std::max(m, 1);
+
+        IncrementalEvaluator evaluator(problem);
+        std::shared_ptr<const CostMatrix> costs = problem.getSearchCosts();
+        FlipNeighbourhood flip;
+        std::vector<Neighbourhood*> neighbourhoods = { &flip };
+
+        std::mt19937_64 generator(streamSeed(0));
+        std::uniform_real_distribution<double> probability(0.0, 1.0);
+
+        EvaluationCache local_cache(m);
+        EvaluationCache& fitness_cache = evaluation_cache != nullptr ? *evaluation_cache : local_cache;
+        std::vector<std::uint64_t> batch_hash;
+
+        std::vector<Individual> population;
+        std::vector<Individual> offspring;
+        std::vector<const PackedBitset*> batch;
+        std::vector<std::size_t> batch_owner;
+        std::vector<double> batch_fitness;
+
+        auto scoreOffspring = [&]() {
+            batch.clear();
+            batch_owner.clear();
+            batch_hash.clear();
+            for (std::size_t c = 0; c < offspring.size(); ++c) {
+                std::uint64_t hash = fitness_cache.hash(offspring[c].genes);
+                if (!fitness_cache.lookup(hash, offspring[c].fitness)) {
+                    batch.push_back(&offspring[c].genes);
+                    batch_owner.push_back(c);
+                    batch_hash.push_back(hash);
+                }
+            }
+            evaluateBatch(*costs, batch, batch_fitness);
+            for (std::size_t b = 0; b < batch.size(); ++b) {
+                offspring[batch_owner[b]].fitness = batch_fitness[b];
+                fitness_cache.store(batch_hash[b], batch_fitness[b]);
+            }
+        };
+
+        for (int p = 0; p < population_size; ++p) {
+            double density = 0.05 + 0.45 * probability(generator);
+            Individual individual{ PackedBitset(m), 0.0 };
+            for (int i = 0; i < m; ++i) {
+                if (probability(generator) < density) {
+                    individual.genes.set(i);
+                }
+            }
+            if (individual.genes.count() == 0) {
+                individual.genes.set(std::uniform_int_distribution<int>(0, m - 1)(generator));
+            }
+            offspring.push_back(std::move(individual));
+        }
+
+        // A warm start replaces the first random individual
+        std::vector<bool> start = getInitialOpenSet(problem);
+        if (!start.empty() && !offspring.empty()) {
+            for (int i = 0; i < m; ++i) {
+                if (start[i]) offspring.front().genes.set(i); else offspring.front().genes.reset(i);
+            }
+        }
+        scoreOffspring();
+        population.swap(offspring);
+
+        std::uniform_int_distribution<int> pick(0, population_size - 1);
+        auto tournament = [&]() -> const Individual& {
+            const Individual& a = population[pick(generator)];
+            const Individual& b = population[pick(generator)];
+            return a.fitness <= b.fitness ? a : b;
+        };
+
+        for (int generation = 0; generation < generations && !stopRequested(); ++generation) {
+            offspring.clear();
+
+            for (int c = 0; c < population_size; ++c) {
+                const Individual& a = tournament();
+                const Individual& b = tournament();
+
+                Individual child{ probability(generator) < path_relinking_rate
+                                      ? pathRelinkingCrossover(evaluator, a.genes, b.genes, generator)
+                                      : uniformCrossover(a.genes, b.genes, generator),
+                                  0.0 };
+                mutate(child.genes, mutation_rate, generator);
+
+                if (probability(generator) < local_search_rate) {
+                    evaluator.reset(child.genes.toVector());
+                    variableNeighbourhoodDescent(evaluator, neighbourhoods);
+                    for (int i = 0; i < m; ++i) {
+                        if (evaluator.isOpen(i)) child.genes.set(i); else child.genes.reset(i);
+                    }
+                }
+                offspring.push_back(std::move(child));
+            }
+            scoreOffspring();
+
+            for (auto& individual : population) {
+                offspring.push_back(std::move(individual));
+            }
+            std::sort(offspring.begin(), offspring.end(),
+                      [](const Individual& x, const Individual& y) { return x.fitness < y.fitness; });
+
+            population.clear();
+            for (auto& individual : offspring) {
+                if (static_cast<int>(population.size()) == population_size) {
+                    break;
+                }
+                if (population.empty() || !(individual.genes == population.back().genes)) {
+                    population.push_back(std::move(individual));
+                }
+            }
+            while (static_cast<int>(population.size()) < population_size) {
+                population.push_back(population[pick(generator) % population.size()]);
+            }
+
+            UFLP_LOG_TRACE("Generation %d: best %f", generation, population.front().fitness);
+        }
+
+        UFLP_LOG_DEBUG("Genetic algorithm: best %f, fitness cache %llu hits, %llu misses (%.1f%% hit rate)",
+                       population.front().fitness, static_cast<unsigned long long>(fitness_cache.getHits()),
+                       static_cast<unsigned long long>(fitness_cache.getMisses()), 100.0 * fitness_cache.getHitRate());
+
+        if (elite_pool) {
+            for (const auto& individual : population) {
+                elite_pool->add(individual.genes, individual.fitness);
+            }
+        }
+
+        evaluator.reset(population.front().genes.toVector());
+        return evaluator.getAssignments();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Algorithm.hpp"
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Memetic genetic algorithm over packed open-facility bitsets.
+     *
+     * Individuals are PackedBitsets. Uniform crossover combines the parents one 64-bit word
+     * at a time with a random mask. Path-relinking crossover walks from one parent towards
+     * the other a word at a time and keeps the best intermediate. Offspring whose fitness is
+     * not already memoised in the evaluation cache are scored together in one
+     * population-batched pass over the cost matrix. Each generation keeps the best distinct
+     * individuals among parents and offspring. A share of the offspring is polished by a
+     * flip descent first.
+     */
+    class GeneticAlgorithm : public Algorithm {
+    public:
+        GeneticAlgorithm(int population_size, int generations, double path_relinking_rate = 0.2,
+                         double local_search_rate = 0.1, unsigned int seed = 0)
+            : population_size(population_size), generations(generations),
+              path_relinking_rate(path_relinking_rate), local_search_rate(local_search_rate) {
+            setSeed(seed);
+        }
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+    private:
+        int population_size;
+        int generations;
+        double path_relinking_rate;
+        double local_search_rate;
+    };
+}
@@ -0,0 +1,204 @@
+#include "GreedyAlgorithm.hpp"
+#include "IncrementalEvaluator.hpp"
+#include "Neighbourhood.hpp"
+#include "../misc/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace algorithm {
+
+    int GreedyAlgorithm::greedyFlips(IncrementalEvaluator& evaluator, bool opening) const {
+        struct Candidate {
+            double saving;
+            int facility;
+            int version;
+
+            bool operator<(const Candidate& other) const {
+                return saving < other.saving || (saving == other.saving && facility > other.facility);
+            }
+        };
+
+        const int n = evaluator.getNumberOfCustomers();
+        const int m = evaluator.getNumberOfWarehouses();
+        const SparseCosts* sparse = evaluator.getSparseCosts();
+        int flips = 0;
+
+        // From an empty solution every saving is infinite; open the best single facility first
+        if (opening && evaluator.getOpenCount() == 0 && m > 0) {
+            std::vector<double> alone(m);
+            for (int i = 0; i < m; ++i) {
+                alone[i] = evaluator.getFixedCost(i);
+            }
+            if (sparse) {
+                for (int i = 0; i < m; ++i) {
+                    alone[i] += static_cast<double>(n - (sparse->columnEnd(i) - sparse->columnBegin(i))) * evaluator.getUnservedCost();
+                    for (std::size_t e = sparse->columnBegin(i); e < sparse->columnEnd(i); ++e) {
+                        alone[i] += sparse->getColumnCost(e);
+                    }
+                }
+            }
+            else {
+                for (int j = 0; j < n; ++j) {
+                    const double* row = evaluator.getCostRow(j);
+                    for (int i = 0; i < m; ++i) {
+                        alone[i] += row[i];
+                    }
+                }
+            }
+            evaluator.flip(static_cast<int>(std::min_element(alone.begin(), alone.end()) - alone.begin()));
+            ++flips;
+        }
+
+        std::vector<double> saving;
+        evaluator.computeFlipDeltas(saving);
+        for (double& value : saving) {
+            value = -value;
+        }
+
+        std::vector<int> version(m, 0);
+        std::priority_queue<Candidate> heap;
+        for (int i = 0; i < m; ++i) {
+            if (evaluator.isOpen(i) != opening) {
+                heap.push({ saving[i], i, 0 });
+            }
+        }
+
+        std::vector<int> touched;
+        std::vector<int> touched_at(m, -1);
+        auto touch = [&](int i) {
+            if (i >= 0 && touched_at[i] != flips) {
+                touched_at[i] = flips;
+                touched.push_back(i);
+            }
+        };
+
+        struct Move {
+            int customer;
+            int nearest;
+            double cost; // Nearest cost when opening, second minus nearest cost when closing
+        };
+        std::vector<Move> moved;
+
+        while (!heap.empty() && !stopRequested()) {
+            Candidate top = heap.top();
+            heap.pop();
+            if (evaluator.isOpen(top.facility) == opening || top.version != version[top.facility]) {
+                continue; // Outdated entry
+            }
+            if (!(top.saving > 1e-9 * std::max(1.0, std::abs(evaluator.getCost())))) {
+                break;
+            }
+            if (!opening && evaluator.getOpenCount() == 1) {
+                break;
+            }
+
+            const int k = top.facility;
+            touched.clear();
+            moved.clear();
+
+            if (opening) {
+                // Customers that k serves more cheaply than their nearest open facility
+                if (sparse) {
+                    for (std::size_t e = sparse->columnBegin(k); e < sparse->columnEnd(k); ++e) {
+                        int j = sparse->getColumnCustomer(e);
+                        if (sparse->getColumnCost(e) < evaluator.getNearestCost(j)) {
+                            moved.push_back({ j, evaluator.getNearest(j), evaluator.getNearestCost(j) });
+                        }
+                    }
+                }
+                else {
+                    for (int j = 0; j < n; ++j) {
+                        if (evaluator.getCostRow(j)[k] < evaluator.getNearestCost(j)) {
+                            moved.push_back({ j, evaluator.getNearest(j), evaluator.getNearestCost(j) });
+                        }
+                    }
+                }
+                evaluator.flip(k);
+                ++flips;
+
+                // Only the candidates cheaper than a moved customer's old nearest cost saved on it
+                for (const Move& move : moved) {
+                    double old_cost = move.cost;
+                    double new_cost = evaluator.getNearestCost(move.customer);
+                    if (sparse) {
+                        for (std::size_t e = sparse->rowBegin(move.customer); e < sparse->rowEnd(move.customer) && sparse->getCost(e) < old_cost; ++e) {
+                            int i = sparse->getFacility(e);
+                            saving[i] -= (old_cost - sparse->getCost(e)) - std::max(0.0, new_cost - sparse->getCost(e));
+                            touch(i);
+                        }
+                    }
+                    else {
+                        const double* row = evaluator.getCostRow(move.customer);
+                        for (int i = 0; i < m; ++i) {
+                            if (row[i] < old_cost) {
+                                saving[i] -= (old_cost - row[i]) - std::max(0.0, new_cost - row[i]);
+                                touch(i);
+                            }
+                        }
+                    }
+                }
+            }
+            else {
+                // Customers served by k, or with k as their fallback, change their contribution
+                // (second minus nearest cost) to the cost of closing their nearest facility
+                for (int j = 0; j < n; ++j) {
+                    if (evaluator.getNearest(j) == k || evaluator.getSecondNearest(j) == k) {
+                        moved.push_back({ j, evaluator.getNearest(j), evaluator.getSecondNearestCost(j) - evaluator.getNearestCost(j) });
+                    }
+                }
+                evaluator.flip(k);
+                ++flips;
+
+                for (const Move& move : moved) {
+                    int j = move.customer;
+                    saving[move.nearest] += move.cost;
+                    saving[evaluator.getNearest(j)] -= evaluator.getSecondNearestCost(j) - evaluator.getNearestCost(j);
+                    touch(move.nearest);
+                    touch(evaluator.getNearest(j));
+                }
+            }
+
+            for (int i : touched) {
+                if (evaluator.isOpen(i) != opening) {
+                    heap.push({ saving[i], i, ++version[i] });
+                }
+            }
+        }
+        return flips;
+    }
+
+    std::vector<bool> GreedyAlgorithm::construct(const Problem& problem) const {
+        std::vector<bool> start = getInitialOpenSet(problem);
+        if (start.empty()) {
+            start.assign(problem.getNumberOfWarehouses(), mode == Mode::Drop);
+        }
+
+        IncrementalEvaluator evaluator(problem);
+        evaluator.reset(start);
+
+        int flips = greedyFlips(evaluator, mode != Mode::Drop);
+        UFLP_LOG_DEBUG("Greedy %s: %d flips to %f", mode == Mode::Drop ? "DROP" : "ADD", flips, evaluator.getCost());
+
+        if (mode == Mode::KuehnHamburger && !stopRequested()) {
+            FlipNeighbourhood bump;
+            SwapNeighbourhood shift(evaluator);
+            int moves = variableNeighbourhoodDescent(evaluator, { &bump, &shift });
+            UFLP_LOG_DEBUG("Greedy bump and shift: %d moves to %f", moves, evaluator.getCost());
+        }
+        return evaluator.getOpenWarehouses();
+    }
+
+    /**
+     * @brief Solves the problem with the selected greedy heuristic.
+     *
+     * @param problem The problem instance to solve.
+     * @return A vector of pairs representing the assignment of customers to warehouses.
+     */
+    std::vector<std::pair<int, int>> GreedyAlgorithm::solve(const Problem& problem) const {
+        IncrementalEvaluator evaluator(problem);
+        evaluator.reset(construct(problem));
+        offerIncumbent(evaluator.getCost(), evaluator.getOpenWarehouses());
+        return evaluator.getAssignments();
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Algorithm.hpp"
+#include <vector>
+
+namespace algorithm {
+
+    class IncrementalEvaluator;
+
+    /**
+     * @brief The classic greedy constructive heuristics for the UFLP.
+     *
+     * ADD starts with every facility closed and keeps opening the facility with the largest
+     * saving; DROP starts with every facility open and keeps closing the one with the largest
+     * saving; both stop when no move saves anything. Kuehn-Hamburger runs ADD and then the
+     * bump (close) and shift (swap) moves until neither improves, i.e. a flip and swap descent.
+     *
+     * The savings of all candidates are kept in a priority queue and updated incrementally.
+     * Opening a facility only revisits the customers it takes over, and for each of them only
+     * the candidates cheaper than its previous nearest facility; closing one only moves the
+     * (second - nearest cost) contribution of the customers that had it as nearest or second
+     * nearest. Updated candidates are pushed again and outdated entries skipped when they
+     * reach the top. ADD from nothing first opens the best single facility. With a warm start,
+     * ADD and DROP continue from the warm-start open set. The results make good starts for
+     * the local searches.
+     */
+    class GreedyAlgorithm : public Algorithm {
+    public:
+        enum class Mode { Add, Drop, KuehnHamburger };
+
+        explicit GreedyAlgorithm(Mode mode = Mode::KuehnHamburger) : mode(mode) {}
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+        /**
+         * @brief The open set the heuristic builds, e.g. for setInitialSolution of another algorithm.
+         */
+        std::vector<bool> construct(const Problem& problem) const;
+
+    private:
+        /**
+         * @brief Applies the best saving flip among closed (opening) or open (closing) facilities until none saves.
+         *
+         * @return The number of facilities flipped.
+         */
+        int greedyFlips(IncrementalEvaluator& evaluator, bool opening) const;
+
+        Mode mode;
+    };
+}
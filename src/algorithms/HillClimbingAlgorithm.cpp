@@ -2,81 +2,124 @@
 #include <limits>
 #include <algorithm>
 #include <chrono>
-#include <iostream>
-#include <iomanip>
+#include "../misc/Logger.hpp"
 
 namespace algorithm {
 
-double HillClimbingAlgorithm::calculateCost(const Problem& problem, const std::vector<bool>& openWarehouses) const {
-    double totalCost = 0.0;
-
-    const auto& warehouses = problem.getWarehouses();
-    const auto& customers = problem.getCustomers();
-
-    for (size_t i = 0; i < openWarehouses.size(); ++i) {
-        if (openWarehouses[i]) {
-            totalCost += warehouses[i].getFixedCost();
-        }
-    }
-
-    for (const auto& customer : customers) {
-        double minCost = std::numeric_limits<double>::max();
-        const auto& allocationCosts = customer.getAllocationCosts();
-
-        for (size_t i = 0; i < openWarehouses.size(); ++i) {
-            if (openWarehouses[i]) {
-                minCost = std::min(minCost, allocationCosts[i]);
-            }
-        }
-
-        totalCost += minCost;
+double HillClimbingAlgorithm::cachedCost(const CostMatrix& costs, const FacilityOrder& order, const std::vector<bool>& openWarehouses, EvaluationCache& cache, std::uint64_t hash) const {
+    double cost;
+    if (!cache.lookup(hash, cost)) {
+        cost = costs.evaluate(openWarehouses, order);
+        cache.store(hash, cost);
     }
-
-    return totalCost;
+    return cost;
 }
 
 void HillClimbingAlgorithm::getInitialSolution(const Problem& problem, std::vector<bool>& openWarehouses) const {
-    // Initially open all warehouses
-    openWarehouses.assign(problem.getNumberOfWarehouses(), true);
+    // Start from the warm start if there is one, otherwise open all warehouses
+    openWarehouses = getInitialOpenSet(problem);
+    if (openWarehouses.empty()) {
+        openWarehouses.assign(problem.getNumberOfWarehouses(), true);
+    }
 }
 
-void HillClimbingAlgorithm::getBestNeighbor(const Problem& problem, const std::vector<bool>& currentSolution, std::vector<bool>& bestNeighbor) const {
+void HillClimbingAlgorithm::getBestNeighbor(const CostMatrix& costs, const FacilityOrder& order, const std::vector<bool>& currentSolution, std::vector<bool>& bestNeighbor,
+                                             EvaluationCache& cache, std::uint64_t currentHash) const {
+    // Neighbours missing from the cache are evaluated batchSize at a time, each batch in one tiled sweep of
+    // the cost matrix. A batch expands every open set to an m-entry mask, so it has to stay small.
+    const size_t batchSize = 64;
+    const size_t m = currentSolution.size();
+    std::vector<std::vector<bool>> neighbors(std::min(batchSize, m), currentSolution);
+    std::vector<const std::vector<bool>*> batch;
+    std::vector<size_t> batchOwner;
+    std::vector<std::uint64_t> batchHash;
+    std::vector<double> batchCosts;
+
     double bestCost = std::numeric_limits<double>::max();
-    bestNeighbor = currentSolution;
+    size_t best = m;
+    auto consider = [&](size_t i, double cost) {
+        if (cost < bestCost || (cost == bestCost && i < best)) {
+            bestCost = cost;
+            best = i;
+        }
+    };
+    auto evaluatePending = [&]() {
+        costs.evaluateBatch(batch, order, batchCosts);
+        for (size_t b = 0; b < batch.size(); ++b) {
+            cache.store(batchHash[b], batchCosts[b]);
+            consider(batchOwner[b], batchCosts[b]);
+            neighbors[b][batchOwner[b]] = currentSolution[batchOwner[b]]; // Back to the current solution for reuse
+        }
+        batch.clear();
+        batchOwner.clear();
+        batchHash.clear();
+    };
+
+    for (size_t i = 0; i < m; ++i) {
+        std::uint64_t hash = cache.flipHash(currentHash, static_cast<int>(i));
+        double cost;
+        if (cache.lookup(hash, cost)) {
+            consider(i, cost);
+            continue;
+        }
 
-    for (size_t i = 0; i < currentSolution.size(); ++i) {
-        std::vector<bool> neighbor = currentSolution;
+        std::vector<bool>& neighbor = neighbors[batch.size()];
         neighbor[i] = !neighbor[i]; // Toggle the state of the ith warehouse
-
-        double neighborCost = calculateCost(problem, neighbor);
-        if (neighborCost < bestCost) {
-            bestCost = neighborCost;
-            bestNeighbor = neighbor;
+        batch.push_back(&neighbor);
+        batchOwner.push_back(i);
+        batchHash.push_back(hash);
+        if (batch.size() == neighbors.size()) {
+            evaluatePending();
         }
     }
+    if (!batch.empty()) {
+        evaluatePending();
+    }
+
+    bestNeighbor = currentSolution;
+    if (best < m) {
+        bestNeighbor[best] = !bestNeighbor[best];
+    }
 }
 
 std::vector<std::pair<int, int>> HillClimbingAlgorithm::solve(const Problem& problem) const {
     std::vector<bool> currentSolution;
     getInitialSolution(problem, currentSolution);
 
-    double currentCost = calculateCost(problem, currentSolution);
+    // Searched in the problem's search precision, re-scored exactly at the end
+    std::shared_ptr<const CostMatrix> costs = problem.getSearchCosts();
+
+    // Most facilities stay open, so each customer's nearest open facility is near the front of its sorted list.
+    // Sparse rows are already sorted and their cost matrix walks them directly, so it gets an empty order.
+    std::shared_ptr<const FacilityOrder> order = problem.getFacilityOrder();
+    if (!order) {
+        order = problem.isSparse() ? std::make_shared<const FacilityOrder>(std::vector<Customer>(), 0)
+                                   : std::make_shared<const FacilityOrder>(problem.getCustomers(), problem.getNumberOfWarehouses());
+    }
+
+    EvaluationCache localCache(problem.getNumberOfWarehouses());
+    EvaluationCache& cache = evaluation_cache != nullptr ? *evaluation_cache : localCache;
+    std::uint64_t currentHash = cache.hash(currentSolution);
+
+    double currentCost = cachedCost(*costs, *order, currentSolution, cache, currentHash);
     bool localOptimum = false;
 
     int iteration = 0;
 
-    while (!localOptimum) {
+    while (!localOptimum && !stopRequested()) {
         ++iteration;
 
         auto start = std::chrono::high_resolution_clock::now();
         std::vector<bool> neighborSolution;
-        getBestNeighbor(problem, currentSolution, neighborSolution);
-    
-        double neighborCost = calculateCost(problem, neighborSolution);
+        getBestNeighbor(*costs, *order, currentSolution, neighborSolution, cache, currentHash);
+
+        std::uint64_t neighborHash = cache.hash(neighborSolution);
+        double neighborCost = cachedCost(*costs, *order, neighborSolution, cache, neighborHash);
         
         if (neighborCost < currentCost) {
             currentSolution = neighborSolution;
             currentCost = neighborCost;
+            currentHash = neighborHash;
         } else {
             localOptimum = true;
         }
@@ -84,28 +127,14 @@ std::vector<std::pair<int, int>> HillClimbingAlgorithm::solve(const Problem& pro
         auto end = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> elapsed = end - start;
     
-        std::cout << "Iteration " << iteration << " time: " << std::fixed << std::setprecision(2) << elapsed.count() << "s. New total cost: " << currentCost << std::endl;
+        UFLP_LOG_DEBUG("Iteration %d time: %.2fs. New total cost: %.2f", iteration, elapsed.count(), currentCost);
     }
 
-    std::vector<std::pair<int, int>> assignments;
-    const auto& customers = problem.getCustomers();
-
-    for (size_t i = 0; i < customers.size(); ++i) {
-        const auto& allocationCosts = customers[i].getAllocationCosts();
-        int bestWarehouse = -1;
-        double minCost = std::numeric_limits<double>::max();
-
-        for (size_t j = 0; j < currentSolution.size(); ++j) {
-            if (currentSolution[j] && allocationCosts[j] < minCost) {
-                minCost = allocationCosts[j];
-                bestWarehouse = static_cast<int>(j);
-            }
-        }
-
-        assignments.emplace_back(static_cast<int>(i), bestWarehouse);
-    }
+    UFLP_LOG_DEBUG("Hill climbing evaluation cache: %llu hits, %llu misses (%.1f%% hit rate)",
+                   static_cast<unsigned long long>(cache.getHits()), static_cast<unsigned long long>(cache.getMisses()),
+                   100.0 * cache.getHitRate());
 
-    return assignments;
+    return problem.assignToNearest(currentSolution);
 }
 
 } // namespace algorithm
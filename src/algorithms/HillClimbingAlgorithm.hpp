@@ -1,5 +1,6 @@
 #pragma once
 #include "Algorithm.hpp"
+#include "EvaluationCache.hpp"
 #include <vector>
 
 namespace algorithm {
@@ -9,9 +10,10 @@ public:
     std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
 
 private:
-    double calculateCost(const Problem& problem, const std::vector<bool>& openWarehouses) const;
+    double cachedCost(const CostMatrix& costs, const FacilityOrder& order, const std::vector<bool>& openWarehouses, EvaluationCache& cache, std::uint64_t hash) const;
     void getInitialSolution(const Problem& problem, std::vector<bool>& openWarehouses) const;
-    void getBestNeighbor(const Problem& problem, const std::vector<bool>& currentSolution, std::vector<bool>& bestNeighbor) const;
+    void getBestNeighbor(const CostMatrix& costs, const FacilityOrder& order, const std::vector<bool>& currentSolution, std::vector<bool>& bestNeighbor,
+                         EvaluationCache& cache, std::uint64_t currentHash) const;
 };
 
 } 
@@ -0,0 +1,389 @@
+#include "IncrementalEvaluator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace algorithm {
+
+    namespace {
+        const double INFINITE_COST = std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * @brief Copies a dense instance into a flat customer-major cost matrix; a sparse one is shared. All facilities start closed.
+     */
+    IncrementalEvaluator::IncrementalEvaluator(const Problem& problem)
+        : number_of_customers(problem.getNumberOfCustomers()),
+          number_of_warehouses(problem.getNumberOfWarehouses()),
+          fixed_costs(problem.getNumberOfWarehouses()),
+          order(problem.getFacilityOrder()),
+          sparse(problem.getSparseCosts()),
+          unserved_cost(INFINITE_COST),
+          open(problem.getNumberOfWarehouses(), 0),
+          open_count(0),
+          nearest(problem.getNumberOfCustomers(), -1),
+          second(problem.getNumberOfCustomers(), -1),
+          nearest_cost(problem.getNumberOfCustomers(), INFINITE_COST),
+          second_cost(problem.getNumberOfCustomers(), INFINITE_COST),
+          fixed_total(0.0),
+          allocation_total(INFINITE_COST) {
+        const auto& warehouses = problem.getWarehouses();
+        const auto& customers = problem.getCustomers();
+
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            fixed_costs[i] = warehouses[i].getFixedCost();
+        }
+
+        if (sparse) {
+            unserved_cost = 1.0;
+            for (int i = 0; i < number_of_warehouses; ++i) {
+                unserved_cost += std::abs(fixed_costs[i]);
+            }
+            for (int j = 0; j < number_of_customers; ++j) {
+                unserved_cost += std::abs(sparse->getLargestCost(j));
+            }
+            return;
+        }
+
+        costs.resize(static_cast<std::size_t>(number_of_customers) * number_of_warehouses);
+        for (int j = 0; j < number_of_customers; ++j) {
+            const auto& allocation_costs = customers[j].getAllocationCosts();
+            double* row = &costs[static_cast<std::size_t>(j) * number_of_warehouses];
+            for (int i = 0; i < number_of_warehouses; ++i) {
+                row[i] = allocation_costs[i];
+            }
+        }
+    }
+
+    template <typename Index>
+    void IncrementalEvaluator::walkCustomer(int j, const Index* facilities) {
+        const double* row = &costs[static_cast<std::size_t>(j) * number_of_warehouses];
+        int found[2] = { -1, -1 };
+        int count = 0;
+
+        for (int rank = 0; rank < number_of_warehouses && count < 2; ++rank) {
+            if (open[facilities[rank]]) {
+                found[count++] = facilities[rank];
+            }
+        }
+
+        nearest[j] = found[0];
+        nearest_cost[j] = found[0] == -1 ? INFINITE_COST : row[found[0]];
+        second[j] = found[1];
+        second_cost[j] = found[1] == -1 ? INFINITE_COST : row[found[1]];
+    }
+
+    void IncrementalEvaluator::rescanCustomer(int j) {
+        if (sparse) {
+            int found[2] = { -1, -1 };
+            double found_cost[2] = { INFINITE_COST, INFINITE_COST };
+            int count = 0;
+            for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j) && count < 2; ++e) {
+                if (open[sparse->getFacility(e)]) {
+                    found[count] = sparse->getFacility(e);
+                    found_cost[count++] = sparse->getCost(e);
+                }
+            }
+
+            double missing = open_count == 0 ? INFINITE_COST : unserved_cost;
+            nearest[j] = found[0];
+            nearest_cost[j] = found[0] == -1 ? missing : found_cost[0];
+            second[j] = found[1];
+            second_cost[j] = found[1] == -1 ? missing : found_cost[1];
+            return;
+        }
+
+        if (order) {
+            if (order->isNarrow()) {
+                walkCustomer(j, order->getNarrowRow(j));
+            }
+            else {
+                walkCustomer(j, order->getWideRow(j));
+            }
+            return;
+        }
+
+        const double* row = &costs[static_cast<std::size_t>(j) * number_of_warehouses];
+        int best = -1, next = -1;
+        double best_cost = INFINITE_COST, next_cost = INFINITE_COST;
+
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            if (!open[i]) {
+                continue;
+            }
+            if (row[i] < best_cost) {
+                next = best;
+                next_cost = best_cost;
+                best = i;
+                best_cost = row[i];
+            }
+            else if (row[i] < next_cost) {
+                next = i;
+                next_cost = row[i];
+            }
+        }
+
+        nearest[j] = best;
+        nearest_cost[j] = best_cost;
+        second[j] = next;
+        second_cost[j] = next_cost;
+    }
+
+    void IncrementalEvaluator::reset(const std::vector<bool>& open_warehouses) {
+        open_count = 0;
+        fixed_total = 0.0;
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            open[i] = open_warehouses[i] ? 1 : 0;
+            if (open[i]) {
+                ++open_count;
+                fixed_total += fixed_costs[i];
+            }
+        }
+
+        allocation_total = 0.0;
+        for (int j = 0; j < number_of_customers; ++j) {
+            rescanCustomer(j);
+            allocation_total += nearest_cost[j];
+        }
+    }
+
+    double IncrementalEvaluator::flipDelta(int i) const {
+        if (open[i]) {
+            if (open_count == 1) {
+                return INFINITE_COST;
+            }
+            double delta = -fixed_costs[i];
+            for (int j = 0; j < number_of_customers; ++j) {
+                if (nearest[j] == i) {
+                    delta += second_cost[j] - nearest_cost[j];
+                }
+            }
+            return delta;
+        }
+
+        if (open_count == 0) {
+            double delta = fixed_costs[i];
+            if (sparse) {
+                std::size_t served = sparse->columnEnd(i) - sparse->columnBegin(i);
+                delta += static_cast<double>(number_of_customers - served) * unserved_cost;
+                for (std::size_t e = sparse->columnBegin(i); e < sparse->columnEnd(i); ++e) {
+                    delta += sparse->getColumnCost(e);
+                }
+                return delta - allocation_total;
+            }
+            for (int j = 0; j < number_of_customers; ++j) {
+                delta += getAllocationCost(j, i);
+            }
+            return delta - allocation_total;
+        }
+
+        double delta = fixed_costs[i];
+        if (sparse) {
+            for (std::size_t e = sparse->columnBegin(i); e < sparse->columnEnd(i); ++e) {
+                double difference = sparse->getColumnCost(e) - nearest_cost[sparse->getColumnCustomer(e)];
+                if (difference < 0) {
+                    delta += difference;
+                }
+            }
+            return delta;
+        }
+        for (int j = 0; j < number_of_customers; ++j) {
+            double difference = getAllocationCost(j, i) - nearest_cost[j];
+            if (difference < 0) {
+                delta += difference;
+            }
+        }
+        return delta;
+    }
+
+    void IncrementalEvaluator::computeFlipDeltas(std::vector<double>& deltas) const {
+        deltas.resize(number_of_warehouses);
+
+        if (open_count == 0) {
+            for (int i = 0; i < number_of_warehouses; ++i) {
+                deltas[i] = flipDelta(i);
+            }
+            return;
+        }
+
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            deltas[i] = open[i] ? -fixed_costs[i] : fixed_costs[i];
+        }
+
+        if (sparse) {
+            // Rows are sorted, so only the entries cheaper than the nearest open facility can improve
+            for (int j = 0; j < number_of_customers; ++j) {
+                double current = nearest_cost[j];
+                if (nearest[j] != -1) {
+                    deltas[nearest[j]] += second_cost[j] - current;
+                }
+                for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j); ++e) {
+                    double difference = sparse->getCost(e) - current;
+                    if (difference >= 0) {
+                        break;
+                    }
+                    deltas[sparse->getFacility(e)] += difference;
+                }
+            }
+        }
+        else {
+            for (int j = 0; j < number_of_customers; ++j) {
+                const double* row = &costs[static_cast<std::size_t>(j) * number_of_warehouses];
+                double current = nearest_cost[j];
+                deltas[nearest[j]] += second_cost[j] - current;
+
+                for (int i = 0; i < number_of_warehouses; ++i) {
+                    double difference = row[i] - current;
+                    if (difference < 0 && !open[i]) {
+                        deltas[i] += difference;
+                    }
+                }
+            }
+        }
+
+        if (open_count == 1) {
+            for (int i = 0; i < number_of_warehouses; ++i) {
+                if (open[i]) {
+                    deltas[i] = INFINITE_COST;
+                }
+            }
+        }
+    }
+
+    void IncrementalEvaluator::flip(int i) {
+        if (!open[i]) {
+            open[i] = 1;
+            ++open_count;
+            fixed_total += fixed_costs[i];
+
+            if (open_count == 1) {
+                allocation_total = 0.0;
+                for (int j = 0; j < number_of_customers; ++j) {
+                    rescanCustomer(j);
+                    allocation_total += nearest_cost[j];
+                }
+                return;
+            }
+
+            auto update = [this, i](int j, double cost) {
+                if (cost < nearest_cost[j]) {
+                    allocation_total += cost - nearest_cost[j];
+                    second[j] = nearest[j];
+                    second_cost[j] = nearest_cost[j];
+                    nearest[j] = i;
+                    nearest_cost[j] = cost;
+                }
+                else if (cost < second_cost[j]) {
+                    second[j] = i;
+                    second_cost[j] = cost;
+                }
+            };
+
+            if (sparse) {
+                for (std::size_t e = sparse->columnBegin(i); e < sparse->columnEnd(i); ++e) {
+                    update(sparse->getColumnCustomer(e), sparse->getColumnCost(e));
+                }
+                return;
+            }
+            for (int j = 0; j < number_of_customers; ++j) {
+                update(j, costs[static_cast<std::size_t>(j) * number_of_warehouses + i]);
+            }
+            return;
+        }
+
+        open[i] = 0;
+        --open_count;
+        fixed_total -= fixed_costs[i];
+
+        if (open_count == 0) {
+            for (int j = 0; j < number_of_customers; ++j) {
+                nearest[j] = second[j] = -1;
+                nearest_cost[j] = second_cost[j] = INFINITE_COST;
+            }
+            allocation_total = INFINITE_COST;
+            return;
+        }
+
+        for (int j = 0; j < number_of_customers; ++j) {
+            if (nearest[j] == i || second[j] == i) {
+                double previous = nearest_cost[j];
+                rescanCustomer(j);
+                allocation_total += nearest_cost[j] - previous;
+            }
+        }
+    }
+
+    void IncrementalEvaluator::addCustomer(const std::vector<double>& allocation_costs) {
+        if (sparse) {
+            throw std::logic_error("Customers of a sparse problem cannot be added or removed");
+        }
+        if (static_cast<int>(allocation_costs.size()) != number_of_warehouses) {
+            throw std::invalid_argument("Customer costs do not match the number of warehouses");
+        }
+
+        order.reset();
+        costs.insert(costs.end(), allocation_costs.begin(), allocation_costs.end());
+        int j = number_of_customers++;
+        nearest.push_back(-1);
+        second.push_back(-1);
+        nearest_cost.push_back(INFINITE_COST);
+        second_cost.push_back(INFINITE_COST);
+
+        rescanCustomer(j);
+        if (open_count > 0) {
+            allocation_total += nearest_cost[j];
+        }
+    }
+
+    void IncrementalEvaluator::removeCustomer(int j) {
+        if (sparse) {
+            throw std::logic_error("Customers of a sparse problem cannot be added or removed");
+        }
+        if (j < 0 || j >= number_of_customers) {
+            throw std::out_of_range("Customer index out of range");
+        }
+
+        order.reset();
+        if (open_count > 0) {
+            allocation_total -= nearest_cost[j];
+        }
+
+        int last = --number_of_customers;
+        std::copy(costs.begin() + static_cast<std::size_t>(last) * number_of_warehouses, costs.end(),
+                  costs.begin() + static_cast<std::size_t>(j) * number_of_warehouses);
+        costs.resize(static_cast<std::size_t>(last) * number_of_warehouses);
+        nearest[j] = nearest[last];
+        second[j] = second[last];
+        nearest_cost[j] = nearest_cost[last];
+        second_cost[j] = second_cost[last];
+        nearest.pop_back();
+        second.pop_back();
+        nearest_cost.pop_back();
+        second_cost.pop_back();
+    }
+
+    void IncrementalEvaluator::setFixedCost(int i, double cost) {
+        if (open[i]) {
+            fixed_total += cost - fixed_costs[i];
+        }
+        fixed_costs[i] = cost;
+    }
+
+    std::vector<bool> IncrementalEvaluator::getOpenWarehouses() const {
+        std::vector<bool> result(number_of_warehouses);
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            result[i] = open[i] != 0;
+        }
+        return result;
+    }
+
+    std::vector<std::pair<int, int>> IncrementalEvaluator::getAssignments() const {
+        std::vector<std::pair<int, int>> assignments;
+        assignments.reserve(number_of_customers);
+        for (int j = 0; j < number_of_customers; ++j) {
+            assignments.emplace_back(j, nearest[j]);
+        }
+        return assignments;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include "../problem/Problem.hpp"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Keeps the cost of an open-facility set up to date under single-facility flips.
+     *
+     * For every customer the evaluator stores its nearest and second-nearest open facility,
+     * which is enough to price opening or closing any facility in O(n) and to price every
+     * flip at once in a single O(n*m) pass. Applying a flip only rescans the customers whose
+     * nearest or second-nearest facility was closed.
+     *
+     * If the problem has a sorted facility order (Problem::buildFacilityOrder), rescans walk
+     * each customer's sorted list up to the second open facility instead of scanning all m.
+     *
+     * On a sparse problem (Problem::isSparse) the evaluator keeps no dense copy: rescans walk
+     * the customer's sorted row, opening a facility touches only its column, and the flip
+     * pass stops each row at the customer's nearest open facility, so every operation scales
+     * with the stored entries. A customer with no open facility in its row is charged
+     * getUnservedCost(), a finite stand-in for infinity larger than the cost of any feasible
+     * solution, so deltas stay finite and the search is driven back to feasibility.
+     */
+    class IncrementalEvaluator {
+    public:
+        explicit IncrementalEvaluator(const Problem& problem);
+
+        /**
+         * @brief Replaces the current open set and recomputes everything from scratch.
+         */
+        void reset(const std::vector<bool>& open);
+
+        /**
+         * @brief Change in total cost if facility i were flipped. Infinite when closing the last open facility.
+         */
+        double flipDelta(int i) const;
+
+        /**
+         * @brief Fills deltas[i] with flipDelta(i) for every facility in one pass over the customers.
+         */
+        void computeFlipDeltas(std::vector<double>& deltas) const;
+
+        /**
+         * @brief Opens facility i if closed, closes it if open, and updates the cost.
+         */
+        void flip(int i);
+
+        /**
+         * @brief Appends a customer of a dense problem and finds its nearest open facilities. O(m).
+         * The sorted facility order no longer covers every customer, so rescans scan from now on.
+         */
+        void addCustomer(const std::vector<double>& allocation_costs);
+
+        /**
+         * @brief Removes customer j; the last customer takes index j, as in Problem::removeCustomer. O(m).
+         */
+        void removeCustomer(int j);
+
+        /**
+         * @brief Changes the fixed cost of facility i. O(1).
+         */
+        void setFixedCost(int i, double cost);
+
+        double getCost() const { return fixed_total + allocation_total; }
+        bool isOpen(int i) const { return open[i] != 0; }
+        int getOpenCount() const { return open_count; }
+        int getNumberOfCustomers() const { return number_of_customers; }
+        int getNumberOfWarehouses() const { return number_of_warehouses; }
+        int getNearest(int j) const { return nearest[j]; }
+        int getSecondNearest(int j) const { return second[j]; }
+        double getNearestCost(int j) const { return nearest_cost[j]; }
+        double getSecondNearestCost(int j) const { return second_cost[j]; }
+        double getFixedCost(int i) const { return fixed_costs[i]; }
+        double getAllocationCost(int j, int i) const {
+            return sparse ? sparse->getCost(j, i, unserved_cost) : costs[static_cast<std::size_t>(j) * number_of_warehouses + i];
+        }
+
+        /**
+         * @brief Customer j's dense cost row. Only valid when getSparseCosts() is nullptr.
+         */
+        const double* getCostRow(int j) const { return &costs[static_cast<std::size_t>(j) * number_of_warehouses]; }
+        const SparseCosts* getSparseCosts() const { return sparse.get(); }
+        double getUnservedCost() const { return unserved_cost; }
+
+        std::vector<bool> getOpenWarehouses() const;
+        std::vector<std::pair<int, int>> getAssignments() const;
+
+    private:
+        void rescanCustomer(int j);
+        template <typename Index>
+        void walkCustomer(int j, const Index* facilities);
+
+        int number_of_customers;
+        int number_of_warehouses;
+        std::vector<double> costs;
+        std::vector<double> fixed_costs;
+        std::shared_ptr<const FacilityOrder> order;
+        std::shared_ptr<const SparseCosts> sparse;
+        double unserved_cost;
+
+        std::vector<char> open;
+        int open_count;
+        std::vector<int> nearest;
+        std::vector<int> second;
+        std::vector<double> nearest_cost;
+        std::vector<double> second_cost;
+        double fixed_total;
+        double allocation_total;
+    };
+}
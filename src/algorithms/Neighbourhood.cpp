@@ -0,0 +1,403 @@
+#include "Neighbourhood.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace algorithm {
+
+    namespace {
+        const double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+        bool isImprovement(double delta, double cost) {
+            return delta < -1e-9 * std::max(1.0, std::abs(cost));
+        }
+
+        /**
+         * @brief Counts, for one facility b at a time, the customers every other facility shares with b.
+         */
+        class SharedCustomerCounter {
+        public:
+            explicit SharedCustomerCounter(int m) : shared(m, 0) {}
+
+            void count(int a) {
+                if (shared[a]++ == 0) {
+                    touched.push_back(a);
+                }
+            }
+
+            /**
+             * @brief The (up to) k facilities counted most often, ties to the lower index; resets the counts.
+             */
+            std::vector<int> take(int k) {
+                int size = std::min(k, static_cast<int>(touched.size()));
+                std::partial_sort(touched.begin(), touched.begin() + size, touched.end(), [this](int x, int y) {
+                    return shared[x] > shared[y] || (shared[x] == shared[y] && x < y);
+                });
+                std::vector<int> best(touched.begin(), touched.begin() + size);
+                for (int a : touched) {
+                    shared[a] = 0;
+                }
+                touched.clear();
+                return best;
+            }
+
+        private:
+            std::vector<int> shared;
+            std::vector<int> touched;
+        };
+
+        /**
+         * @brief Candidate lists of a sparse problem: the facilities that share the most customers
+         * with b, counted over (up to) the first 256 customers of b's column.
+         */
+        std::vector<std::vector<int>> buildSparseCandidateLists(const SparseCosts& costs, int k) {
+            const int m = costs.getNumberOfWarehouses();
+            std::vector<std::vector<int>> candidates(m);
+            SharedCustomerCounter counter(m);
+
+            for (int b = 0; b < m; ++b) {
+                std::size_t end = std::min(costs.columnEnd(b), costs.columnBegin(b) + 256);
+                for (std::size_t c = costs.columnBegin(b); c < end; ++c) {
+                    int j = costs.getColumnCustomer(c);
+                    for (std::size_t e = costs.rowBegin(j); e < costs.rowEnd(j); ++e) {
+                        if (costs.getFacility(e) != b) {
+                            counter.count(costs.getFacility(e));
+                        }
+                    }
+                }
+                candidates[b] = counter.take(k);
+            }
+            return candidates;
+        }
+
+        /**
+         * @brief Candidate lists of a dense problem: the facilities that are among the k + 1 cheapest
+         * of most of b's 256 cheapest customers. Two partial selections over the matrix, so O(n*m).
+         */
+        std::vector<std::vector<int>> buildDenseCandidateLists(const IncrementalEvaluator& evaluator, int k) {
+            const int n = evaluator.getNumberOfCustomers();
+            const int m = evaluator.getNumberOfWarehouses();
+            const int facilities_per_customer = std::min(m, k + 1);
+            const int customers_per_facility = std::min(n, 256);
+
+            std::vector<int> nearest(static_cast<std::size_t>(n) * facilities_per_customer);
+            std::vector<int> order(m);
+            for (int j = 0; j < n; ++j) {
+                const double* row = evaluator.getCostRow(j);
+                std::iota(order.begin(), order.end(), 0);
+                std::nth_element(order.begin(), order.begin() + (facilities_per_customer - 1), order.end(),
+                                 [row](int x, int y) { return row[x] < row[y] || (row[x] == row[y] && x < y); });
+                std::copy(order.begin(), order.begin() + facilities_per_customer, nearest.begin() + static_cast<std::size_t>(j) * facilities_per_customer);
+            }
+
+            std::vector<std::vector<int>> candidates(m);
+            SharedCustomerCounter counter(m);
+            std::vector<std::pair<double, int>> column(n);
+
+            for (int b = 0; b < m; ++b) {
+                for (int j = 0; j < n; ++j) {
+                    column[j] = { evaluator.getAllocationCost(j, b), j };
+                }
+                std::nth_element(column.begin(), column.begin() + (customers_per_facility - 1), column.end());
+                for (int c = 0; c < customers_per_facility; ++c) {
+                    const int* facilities = &nearest[static_cast<std::size_t>(column[c].second) * facilities_per_customer];
+                    for (int f = 0; f < facilities_per_customer; ++f) {
+                        if (facilities[f] != b) {
+                            counter.count(facilities[f]);
+                        }
+                    }
+                }
+                candidates[b] = counter.take(k);
+            }
+            return candidates;
+        }
+    }
+
+    void applyMove(IncrementalEvaluator& evaluator, const Move& move) {
+        if (move.open_facility != -1) {
+            evaluator.flip(move.open_facility);
+        }
+        if (move.close_facility != -1) {
+            evaluator.flip(move.close_facility);
+        }
+    }
+
+    Move FlipNeighbourhood::findBestMove(const IncrementalEvaluator& evaluator) {
+        evaluator.computeFlipDeltas(deltas);
+
+        Move best;
+        for (int i = 0; i < evaluator.getNumberOfWarehouses(); ++i) {
+            if (deltas[i] < best.delta) {
+                best.delta = deltas[i];
+                best.open_facility = evaluator.isOpen(i) ? -1 : i;
+                best.close_facility = evaluator.isOpen(i) ? i : -1;
+            }
+        }
+        return best;
+    }
+
+    std::vector<std::vector<int>> buildCandidateLists(const IncrementalEvaluator& evaluator, int candidate_list_size) {
+        const int k = std::min(candidate_list_size, evaluator.getNumberOfWarehouses() - 1);
+
+        if (evaluator.getSparseCosts() != nullptr) {
+            return buildSparseCandidateLists(*evaluator.getSparseCosts(), k);
+        }
+        return buildDenseCandidateLists(evaluator, k);
+    }
+
+    SwapNeighbourhood::SwapNeighbourhood(const IncrementalEvaluator& evaluator, int candidate_list_size)
+        : number_of_warehouses(evaluator.getNumberOfWarehouses()) {
+        const int m = number_of_warehouses;
+
+        if (candidate_list_size > 0 && candidate_list_size < m - 1) {
+            // Symmetric adjacency lists: (a, b) is a candidate swap if either is in the other's list
+            candidates = buildCandidateLists(evaluator, candidate_list_size);
+            for (int b = 0; b < m; ++b) {
+                for (std::size_t c = 0, size = candidates[b].size(); c < size; ++c) {
+                    candidates[candidates[b][c]].push_back(b);
+                }
+            }
+            for (auto& list : candidates) {
+                std::sort(list.begin(), list.end());
+                list.erase(std::unique(list.begin(), list.end()), list.end());
+            }
+        }
+    }
+
+    Move SwapNeighbourhood::findBestMove(const IncrementalEvaluator& evaluator) {
+        const int n = evaluator.getNumberOfCustomers();
+        const int m = number_of_warehouses;
+        Move best;
+
+        if (evaluator.getOpenCount() == 0 || evaluator.getOpenCount() == m) {
+            return best;
+        }
+
+        gain.assign(m, 0.0);
+        loss.assign(m, 0.0);
+
+        const SparseCosts* sparse = evaluator.getSparseCosts();
+
+        // Prices closing open facility a and opening every closed facility in its candidate list (or all),
+        // given the correction of each b in scratch
+        auto priceSwaps = [&](int a, double loss_of_a) {
+            auto consider = [&](int b) {
+                double delta = evaluator.getFixedCost(b) - evaluator.getFixedCost(a) - gain[b] + loss_of_a - scratch[b];
+                if (delta < best.delta) {
+                    best.delta = delta;
+                    best.open_facility = b;
+                    best.close_facility = a;
+                }
+            };
+            if (candidates.empty()) {
+                for (int b = 0; b < m; ++b) {
+                    if (!evaluator.isOpen(b)) {
+                        consider(b);
+                    }
+                }
+            }
+            else {
+                for (int b : candidates[a]) {
+                    if (!evaluator.isOpen(b)) {
+                        consider(b);
+                    }
+                }
+            }
+        };
+        scratch.assign(m, 0.0);
+
+        if (evaluator.getOpenCount() == 1) {
+            double allocation = 0.0;
+            for (int j = 0; j < n; ++j) {
+                allocation += evaluator.getNearestCost(j);
+                if (sparse != nullptr) {
+                    // Every facility starts at the unserved cost; the stored entries replace it
+                    for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j); ++e) {
+                        gain[sparse->getFacility(e)] += sparse->getCost(e) - evaluator.getUnservedCost();
+                    }
+                    continue;
+                }
+                const double* row = evaluator.getCostRow(j);
+                for (int b = 0; b < m; ++b) {
+                    gain[b] += row[b];
+                }
+            }
+            if (sparse != nullptr) {
+                for (int b = 0; b < m; ++b) {
+                    gain[b] += n * evaluator.getUnservedCost();
+                }
+            }
+
+            // gain[b] so far is the allocation cost of serving everyone from b; make it the saving
+            for (int b = 0; b < m; ++b) {
+                gain[b] = allocation - gain[b];
+            }
+
+            // Not getNearest(0): on a sparse problem customer 0 may not reach the open facility
+            int a = 0;
+            while (!evaluator.isOpen(a)) {
+                ++a;
+            }
+            priceSwaps(a, 0.0);
+            return best;
+        }
+
+        // Customers grouped by their nearest open facility; those with none in their row (sparse) go last
+        group_offsets.assign(m + 2, 0);
+        for (int j = 0; j < n; ++j) {
+            int a = evaluator.getNearest(j);
+            ++group_offsets[(a == -1 ? m : a) + 1];
+        }
+        for (int g = 0; g <= m; ++g) {
+            group_offsets[g + 1] += group_offsets[g];
+        }
+        grouped_customers.resize(n);
+        touched.assign(group_offsets.begin(), group_offsets.end() - 1); // Next free slot of every group
+        for (int j = 0; j < n; ++j) {
+            int a = evaluator.getNearest(j);
+            grouped_customers[touched[a == -1 ? m : a]++] = j;
+        }
+
+        correction_offsets.assign(m + 1, 0);
+        corrections.clear();
+        for (int g = 0; g <= m; ++g) {
+            const int a = g < m ? g : -1;
+            touched.clear();
+
+            // Only positive amounts are added, so a zero in scratch marks an untouched facility
+            auto correct = [&](int b, double amount) {
+                if (amount > 0.0) {
+                    if (scratch[b] == 0.0) {
+                        touched.push_back(b);
+                    }
+                    scratch[b] += amount;
+                }
+            };
+
+            for (int c = group_offsets[g]; c < group_offsets[g + 1]; ++c) {
+                const int j = grouped_customers[c];
+                const double d1 = evaluator.getNearestCost(j);
+                const double d2 = evaluator.getSecondNearestCost(j);
+
+                auto price = [&](int b, double cost) {
+                    if (cost < d1) {
+                        gain[b] += d1 - cost;
+                        if (a != -1) {
+                            correct(b, d2 - d1);
+                        }
+                    }
+                    else if (cost < d2 && a != -1) {
+                        correct(b, d2 - cost);
+                    }
+                };
+
+                if (a != -1) {
+                    loss[a] += d2 - d1;
+                }
+                if (sparse != nullptr) {
+                    // A customer with no open facility in its row (a == -1) can only gain
+                    for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j) && sparse->getCost(e) < d2; ++e) {
+                        if (!evaluator.isOpen(sparse->getFacility(e))) {
+                            price(sparse->getFacility(e), sparse->getCost(e));
+                        }
+                    }
+                    continue;
+                }
+
+                const double* row = evaluator.getCostRow(j);
+                for (int b = 0; b < m; ++b) {
+                    if (!evaluator.isOpen(b)) {
+                        price(b, row[b]);
+                    }
+                }
+            }
+
+            if (a != -1) {
+                correction_offsets[a] = corrections.size();
+                for (int b : touched) {
+                    corrections.emplace_back(b, scratch[b]);
+                    scratch[b] = 0.0;
+                }
+                correction_offsets[a + 1] = corrections.size();
+            }
+        }
+
+        for (int a = 0; a < m; ++a) {
+            if (!evaluator.isOpen(a)) {
+                continue;
+            }
+            for (std::size_t e = correction_offsets[a]; e < correction_offsets[a + 1]; ++e) {
+                scratch[corrections[e].first] = corrections[e].second;
+            }
+            priceSwaps(a, loss[a]);
+            for (std::size_t e = correction_offsets[a]; e < correction_offsets[a + 1]; ++e) {
+                scratch[corrections[e].first] = 0.0;
+            }
+        }
+
+        return best;
+    }
+
+    MultiSwapNeighbourhood::MultiSwapNeighbourhood(const IncrementalEvaluator& evaluator, int candidate_list_size)
+        : candidates(buildCandidateLists(evaluator, candidate_list_size)) {}
+
+    /**
+     * Each step closes a random open facility and opens a random closed facility from its candidate
+     * list. When the list has no closed facility left, the step degrades to a random flip.
+     */
+    void MultiSwapNeighbourhood::shake(IncrementalEvaluator& evaluator, int k, std::mt19937& generator) const {
+        const int m = evaluator.getNumberOfWarehouses();
+        std::uniform_int_distribution<int> any_facility(0, m - 1);
+        std::vector<int> open_facilities;
+        std::vector<int> closed_candidates;
+
+        for (int step = 0; step < k; ++step) {
+            open_facilities.clear();
+            for (int i = 0; i < m; ++i) {
+                if (evaluator.isOpen(i)) {
+                    open_facilities.push_back(i);
+                }
+            }
+
+            int a = open_facilities[std::uniform_int_distribution<int>(0, static_cast<int>(open_facilities.size()) - 1)(generator)];
+
+            closed_candidates.clear();
+            for (int b : candidates[a]) {
+                if (!evaluator.isOpen(b)) {
+                    closed_candidates.push_back(b);
+                }
+            }
+
+            if (closed_candidates.empty()) {
+                int i = any_facility(generator);
+                if (!evaluator.isOpen(i) || evaluator.getOpenCount() > 1) {
+                    evaluator.flip(i);
+                }
+                continue;
+            }
+
+            int b = closed_candidates[std::uniform_int_distribution<int>(0, static_cast<int>(closed_candidates.size()) - 1)(generator)];
+            evaluator.flip(b);
+            evaluator.flip(a);
+        }
+    }
+
+    int variableNeighbourhoodDescent(IncrementalEvaluator& evaluator, const std::vector<Neighbourhood*>& neighbourhoods) {
+        int moves = 0;
+        std::size_t k = 0;
+
+        while (k < neighbourhoods.size()) {
+            Move move = neighbourhoods[k]->findBestMove(evaluator);
+            if (move.isValid() && isImprovement(move.delta, evaluator.getCost())) {
+                applyMove(evaluator, move);
+                ++moves;
+                k = 0;
+            }
+            else {
+                ++k;
+            }
+        }
+
+        return moves;
+    }
+}
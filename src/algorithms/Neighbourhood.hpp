@@ -0,0 +1,110 @@
+#pragma once
+#include "IncrementalEvaluator.hpp"
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief A move in facility space: open one facility, close one, or both (a swap).
+     */
+    struct Move {
+        int open_facility = -1;
+        int close_facility = -1;
+        double delta = std::numeric_limits<double>::infinity();
+
+        bool isValid() const {
+            return open_facility != -1 || close_facility != -1;
+        }
+    };
+
+    /**
+     * @brief Applies a move to the evaluator.
+     */
+    void applyMove(IncrementalEvaluator& evaluator, const Move& move);
+
+    /**
+     * @brief A neighbourhood that can find its best move from the evaluator's current state.
+     */
+    class Neighbourhood {
+    public:
+        virtual Move findBestMove(const IncrementalEvaluator& evaluator) = 0;
+        virtual ~Neighbourhood() {}
+    };
+
+    /**
+     * @brief Opening or closing a single facility, all priced in one O(n*m) pass.
+     */
+    class FlipNeighbourhood : public Neighbourhood {
+    public:
+        Move findBestMove(const IncrementalEvaluator& evaluator) override;
+
+    private:
+        std::vector<double> deltas;
+    };
+
+    /**
+     * @brief Closing one open facility and opening one closed facility.
+     *
+     * All swaps are priced together in one pass over the customers, grouped by their nearest
+     * open facility a: it accumulates the saving of opening each closed facility b, the loss of
+     * closing a, and the correction to that loss for the customers of a that b would take over.
+     * Corrections are kept per open facility and only for the b cheaper than some customer's
+     * second-nearest cost, so memory grows with n + m and the entries priced, not with m*m.
+     *
+     * With a candidate list size k > 0, a swap (a, b) is only considered when a is among the k
+     * facilities most similar to b or b among those of a, which keeps swaps local on large instances.
+     */
+    class SwapNeighbourhood : public Neighbourhood {
+    public:
+        explicit SwapNeighbourhood(const IncrementalEvaluator& evaluator, int candidate_list_size = 0);
+
+        Move findBestMove(const IncrementalEvaluator& evaluator) override;
+
+    private:
+        int number_of_warehouses;
+        std::vector<std::vector<int>> candidates; // Sorted facilities each facility may swap with; empty for all
+        std::vector<double> gain;
+        std::vector<double> loss;
+        std::vector<int> group_offsets;           // Customers of nearest facility a (m: none) are
+        std::vector<int> grouped_customers;       // grouped_customers[group_offsets[a] .. group_offsets[a + 1])
+        std::vector<std::size_t> correction_offsets;
+        std::vector<std::pair<int, double>> corrections; // (b, correction) of open facility a, as for the groups
+        std::vector<double> scratch;              // Dense view of one facility's corrections, zero between uses
+        std::vector<int> touched;
+    };
+
+    /**
+     * @brief Builds, for every facility b, the k facilities that share the most nearby customers with it.
+     *
+     * On a dense problem a facility a shares a customer with b when the customer is among b's 256
+     * cheapest and a among the customer's k + 1 cheapest facilities; on a sparse problem, when both
+     * are stored in the customer's row, over (up to) the first 256 customers of b's column. Either
+     * way the build is O(n*m) or O(stored entries), not O(m*m).
+     */
+    std::vector<std::vector<int>> buildCandidateLists(const IncrementalEvaluator& evaluator, int candidate_list_size);
+
+    /**
+     * @brief Random k-swap used for shaking: k swaps between an open facility and a closed one from its candidate list.
+     */
+    class MultiSwapNeighbourhood {
+    public:
+        MultiSwapNeighbourhood(const IncrementalEvaluator& evaluator, int candidate_list_size);
+
+        void shake(IncrementalEvaluator& evaluator, int k, std::mt19937& generator) const;
+
+    private:
+        std::vector<std::vector<int>> candidates;
+    };
+
+    /**
+     * @brief Variable neighbourhood descent: applies the best improving move of the first neighbourhood
+     * that has one, going back to the first after every improvement, until none improves.
+     *
+     * @return The number of moves applied.
+     */
+    int variableNeighbourhoodDescent(IncrementalEvaluator& evaluator, const std::vector<Neighbourhood*>& neighbourhoods);
+}
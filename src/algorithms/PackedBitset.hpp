@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Fixed-size bitset stored as 64-bit words, used for open-facility sets.
+     *
+     * Unlike std::vector<bool> the words are exposed, so crossover, distance and hashing
+     * work on 64 facilities per operation.
+     */
+    class PackedBitset {
+    public:
+        PackedBitset() : number_of_bits(0) {}
+        explicit PackedBitset(int bits) : number_of_bits(bits), words((bits + 63) / 64, 0) {}
+
+        int size() const { return number_of_bits; }
+        int wordCount() const { return static_cast<int>(words.size()); }
+
+        bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+        void set(int i) { words[i >> 6] |= std::uint64_t(1) << (i & 63); }
+        void reset(int i) { words[i >> 6] &= ~(std::uint64_t(1) << (i & 63)); }
+        void flip(int i) { words[i >> 6] ^= std::uint64_t(1) << (i & 63); }
+
+        std::uint64_t& word(int w) { return words[w]; }
+        std::uint64_t word(int w) const { return words[w]; }
+
+        /**
+         * @brief Mask of the valid bits of word w (all ones except in the last word).
+         */
+        std::uint64_t wordMask(int w) const {
+            int remaining = number_of_bits - w * 64;
+            return remaining >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << remaining) - 1;
+        }
+
+        int count() const {
+            int total = 0;
+            for (std::uint64_t w : words) {
+                total += popcount(w);
+            }
+            return total;
+        }
+
+        int hammingDistance(const PackedBitset& other) const {
+            int total = 0;
+            for (std::size_t w = 0; w < words.size(); ++w) {
+                total += popcount(words[w] ^ other.words[w]);
+            }
+            return total;
+        }
+
+        std::vector<bool> toVector() const {
+            std::vector<bool> result(number_of_bits);
+            for (int i = 0; i < number_of_bits; ++i) {
+                result[i] = test(i);
+            }
+            return result;
+        }
+
+        bool operator==(const PackedBitset& other) const {
+            return number_of_bits == other.number_of_bits && words == other.words;
+        }
+
+        static int popcount(std::uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(w);
+#else
+            int total = 0;
+            while (w) {
+                w &= w - 1;
+                ++total;
+            }
+            return total;
+#endif
+        }
+
+        static std::uint64_t mix(std::uint64_t x) {
+            x += 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+    private:
+        int number_of_bits;
+        std::vector<std::uint64_t> words;
+    };
+}
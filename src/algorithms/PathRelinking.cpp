@@ -0,0 +1,120 @@
+#include "PathRelinking.hpp"
+#include "Neighbourhood.hpp"
+#include "../misc/Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace algorithm {
+
+    double PathRelinking::relink(IncrementalEvaluator& evaluator, const PackedBitset& from, const PackedBitset& to,
+                                 PackedBitset& best_open) {
+        const double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+        std::vector<int> difference;
+        for (int i = 0; i < from.size(); ++i) {
+            if (from.test(i) != to.test(i)) {
+                difference.push_back(i);
+            }
+        }
+        if (difference.size() < 2) {
+            return INFINITE_COST;
+        }
+
+        evaluator.reset(from.toVector());
+        double best_cost = INFINITE_COST;
+        std::vector<bool> best_intermediate;
+
+        // The last flip reaches the guiding solution itself, so it is never taken.
+        while (difference.size() > 1) {
+            int best_index = -1;
+            double best_delta = INFINITE_COST;
+            for (int k = 0; k < static_cast<int>(difference.size()); ++k) {
+                double delta = evaluator.flipDelta(difference[k]);
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_index = k;
+                }
+            }
+            if (best_index == -1) {
+                break;
+            }
+
+            evaluator.flip(difference[best_index]);
+            difference[best_index] = difference.back();
+            difference.pop_back();
+
+            if (evaluator.getCost() < best_cost) {
+                best_cost = evaluator.getCost();
+                best_intermediate = evaluator.getOpenWarehouses();
+            }
+        }
+
+        if (best_intermediate.empty()) {
+            return INFINITE_COST;
+        }
+
+        evaluator.reset(best_intermediate);
+        FlipNeighbourhood flip;
+        SwapNeighbourhood swap(evaluator);
+        variableNeighbourhoodDescent(evaluator, { &flip, &swap });
+
+        best_open = PackedBitset(evaluator.getNumberOfWarehouses());
+        for (int i = 0; i < evaluator.getNumberOfWarehouses(); ++i) {
+            if (evaluator.isOpen(i)) {
+                best_open.set(i);
+            }
+        }
+        return evaluator.getCost();
+    }
+
+    ElitePool::Entry PathRelinking::run(const Problem& problem, ElitePool& pool) const {
+        std::vector<ElitePool::Entry> elites = pool.getEntries();
+
+        std::vector<std::pair<int, int>> pairs;
+        for (int a = 0; a < static_cast<int>(elites.size()); ++a) {
+            for (int b = a + 1; b < static_cast<int>(elites.size()); ++b) {
+                pairs.push_back({ a, b });
+            }
+        }
+
+        int threads_to_use = number_of_threads > 0 ? number_of_threads : static_cast<int>(std::thread::hardware_concurrency());
+        threads_to_use = std::max(1, std::min(threads_to_use, static_cast<int>(pairs.size())));
+
+        std::atomic<int> next_pair(0);
+        std::atomic<int> additions(0);
+        auto worker = [&]() {
+            IncrementalEvaluator evaluator(problem);
+            PackedBitset open;
+            for (int p = next_pair.fetch_add(1); p < static_cast<int>(pairs.size()); p = next_pair.fetch_add(1)) {
+                // Elites are sorted by cost, so the walk starts from the better one.
+                const ElitePool::Entry& from = elites[pairs[p].first];
+                const ElitePool::Entry& to = elites[pairs[p].second];
+
+                double cost = relink(evaluator, from.open, to.open, open);
+                if (cost < to.cost && pool.add(open, cost)) {
+                    additions.fetch_add(1);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < threads_to_use; ++t) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        elites = pool.getEntries();
+        UFLP_LOG_DEBUG("Path relinking: %d pairs, %d added to the pool, best %f", static_cast<int>(pairs.size()),
+                       additions.load(), elites.empty() ? 0.0 : elites.front().cost);
+
+        return elites.empty() ? ElitePool::Entry{ PackedBitset(), std::numeric_limits<double>::infinity() }
+                              : elites.front();
+    }
+}
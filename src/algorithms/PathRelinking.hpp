@@ -0,0 +1,45 @@
+#pragma once
+#include "../problem/Problem.hpp"
+#include "ElitePool.hpp"
+#include "IncrementalEvaluator.hpp"
+
+namespace algorithm {
+
+    /**
+     * @brief Path relinking between elite solutions, run as a post-optimisation stage.
+     *
+     * For every pair of elites the walk starts at the better one and flips, one at a time,
+     * the facilities on which the two differ, always taking the flip with the best delta.
+     * The best strict intermediate of the walk is polished with a flip/swap descent and
+     * offered back to the pool. Pairs are relinked in parallel, each thread with its own
+     * evaluator.
+     */
+    class PathRelinking {
+    public:
+        explicit PathRelinking(int number_of_threads = 0) : number_of_threads(number_of_threads) {}
+
+        /**
+         * @brief Relinks every pair of elites of the pool.
+         *
+         * @param problem The problem instance the elites belong to.
+         * @param pool The elite pool; improved solutions are added to it.
+         * @return The best solution of the pool after relinking.
+         */
+        ElitePool::Entry run(const Problem& problem, ElitePool& pool) const;
+
+        /**
+         * @brief Walks from one open set to another and polishes the best strict intermediate.
+         *
+         * @param evaluator Evaluator of the problem; its state is overwritten.
+         * @param from Starting open set.
+         * @param to Guiding open set.
+         * @param best_open Receives the polished open set.
+         * @return Its cost, or infinity if the sets differ in fewer than two facilities.
+         */
+        static double relink(IncrementalEvaluator& evaluator, const PackedBitset& from, const PackedBitset& to,
+                             PackedBitset& best_open);
+
+    private:
+        int number_of_threads;
+    };
+}
@@ -0,0 +1,184 @@
+#include "PortfolioAlgorithm.hpp"
+#include "CrowSearchAlgorithm.hpp"
+#include "GRASP.hpp"
+#include "GeneticAlgorithm.hpp"
+#include "HillClimbingAlgorithm.hpp"
+#include "IncrementalEvaluator.hpp"
+#include "SimulatedAnnealingAlgorithm.hpp"
+#include "TabuSearchAlgorithm.hpp"
+#include "VariableNeighbourhoodSearch.hpp"
+#include "../misc/Logger.hpp"
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace algorithm {
+
+    void PortfolioAlgorithm::addEngine(const std::string& name, std::shared_ptr<Algorithm> engine) {
+        engines.emplace_back(name, std::move(engine));
+    }
+
+    void PortfolioAlgorithm::addDefaultEngines() {
+        addEngine("HC", std::make_shared<HillClimbingAlgorithm>());
+        addEngine("GRASP", std::make_shared<GRASPAlgorithm>(0.5, 10));
+        addEngine("SA", std::make_shared<SimulatedAnnealingAlgorithm>(1000, 0.1, 0.9, 200));
+        addEngine("CSA", std::make_shared<CrowSearchAlgorithm>(400, 0.1, 80000));
+        addEngine("Tabu", std::make_shared<TabuSearchAlgorithm>(10000, 10, 1000));
+        addEngine("VNS", std::make_shared<VariableNeighbourhoodSearch>(5, 50));
+        addEngine("GA", std::make_shared<GeneticAlgorithm>(40, 100));
+    }
+
+    /**
+     * Each engine runs on its own thread. A run that ends behind the incumbent is followed by
+     * another run warm-started from the incumbent; a run that matches or sets it ends the
+     * engine. The calling thread waits for the engines and raises the stop flag once the budget
+     * (or a stop request on the portfolio itself) is reached.
+     */
+    std::vector<std::pair<int, int>> PortfolioAlgorithm::solve(const Problem& problem) const {
+        if (engines.empty()) {
+            throw std::logic_error("The portfolio has no engines");
+        }
+
+        using clock = std::chrono::steady_clock;
+        const auto start_time = clock::now();
+        const int m = problem.getNumberOfWarehouses();
+
+        SharedIncumbent local_incumbent;
+        SharedIncumbent& shared = incumbent != nullptr ? *incumbent : local_incumbent;
+        std::atomic<bool> stop(false);
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        int running = static_cast<int>(engines.size());
+        std::exception_ptr failure;
+
+        results.clear();
+        for (const auto& engine : engines) {
+            results.push_back({ engine.first, std::numeric_limits<double>::infinity(), 0.0, 0 });
+        }
+
+        std::vector<bool> start = getInitialOpenSet(problem);
+        if (!start.empty()) {
+            IncrementalEvaluator evaluator(problem);
+            evaluator.reset(start);
+            shared.offer(evaluator.getCost(), start);
+        }
+
+        auto runEngine = [&](std::size_t e) {
+            Algorithm& engine = *engines[e].second;
+            // The caller's configuration of the engine, given back once the portfolio is done with it
+            const std::uint64_t engine_seed = engine.getSeed();
+            SharedIncumbent* const engine_incumbent = engine.getSharedIncumbent();
+            const std::atomic<bool>* const engine_stop_flag = engine.getStopFlag();
+            const WarmStart engine_warm_start = engine;
+            engine.shareIncumbent(&shared);
+            engine.shareStopFlag(&stop);
+            engine.setInitialSolution(start);
+
+            try {
+                for (int run = 0;; ++run) {
+                    // Engine e runs with stream e of the portfolio's seed, and its restarts with streams of that one
+                    engine.setSeed(deriveSeed(streamSeed(e), run));
+                    std::vector<std::pair<int, int>> assignments = engine.solve(problem);
+                    double cost = problem.evaluate(assignments);
+
+                    std::vector<bool> open(m, false);
+                    for (const auto& assignment : assignments) {
+                        if (assignment.second >= 0) {
+                            open[assignment.second] = true;
+                        }
+                    }
+                    shared.offer(cost, open, &engine);
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        ++results[e].runs;
+                        if (cost < results[e].cost) {
+                            results[e].cost = cost;
+                            results[e].seconds = std::chrono::duration<double>(clock::now() - start_time).count();
+                        }
+                    }
+
+                    if (stop.load() || !(shared.getCost() < cost - 1e-9 * std::max(1.0, std::abs(cost)))) {
+                        break;
+                    }
+                    engine.setInitialSolution(shared.getOpenWarehouses());
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                failure = std::current_exception();
+                stop.store(true);
+            }
+
+            static_cast<WarmStart&>(engine) = engine_warm_start;
+            engine.setSeed(engine_seed);
+            engine.shareIncumbent(engine_incumbent);
+            engine.shareStopFlag(engine_stop_flag);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            --running;
+            finished.notify_all();
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t e = 0; e < engines.size(); ++e) {
+            threads.emplace_back(runEngine, e);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (running > 0) {
+                bool out_of_time = time_limit > 0.0 && std::chrono::duration<double>(clock::now() - start_time).count() >= time_limit;
+                if (out_of_time || stopRequested()) {
+                    stop.store(true);
+                }
+                finished.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+
+        // The winner is the engine whose offer set the returned incumbent, not merely the one with the
+        // best own result: the incumbent may be the warm start, or have come from a solver outside
+        winner.clear();
+        const void* source = shared.getSource();
+        const EngineResult* best = nullptr;
+        for (std::size_t e = 0; e < engines.size(); ++e) {
+            if (engines[e].second.get() == source) {
+                best = &results[e];
+            }
+        }
+        if (best == nullptr && source != nullptr) {
+            // Offered by a solver nested inside one of the engines (e.g. a portfolio of portfolios);
+            // credit the earliest engine that returned the incumbent's cost
+            const double cost = shared.getCost();
+            for (const auto& result : results) {
+                if (std::abs(result.cost - cost) <= 1e-9 * std::max(1.0, std::abs(cost)) && (best == nullptr || result.seconds < best->seconds)) {
+                    best = &result;
+                }
+            }
+        }
+        if (best != nullptr) {
+            winner = best->name;
+            UFLP_LOG_INFO("Portfolio: %s won with %f after %.3f s", best->name.c_str(), best->cost, best->seconds);
+        }
+        else {
+            UFLP_LOG_INFO("Portfolio: no engine improved on the starting incumbent %f", shared.getCost());
+        }
+
+        IncrementalEvaluator evaluator(problem);
+        evaluator.reset(shared.getOpenWarehouses());
+        return evaluator.getAssignments();
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "Algorithm.hpp"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Runs several algorithms concurrently, one thread each, under one time budget.
+     *
+     * The engines share one SharedIncumbent: the ones that can publish their new bests or
+     * prune against it do so while they run, and every finished run is offered to it. An
+     * engine that finishes behind the incumbent is restarted, warm-started from it, while
+     * the budget lasts. When the budget runs out the engines are asked to stop and return
+     * their best so far. The overall best is returned, and the engine whose offer set it is
+     * recorded for later selection.
+     *
+     * Every run of every engine gets its own stream of the portfolio's seed, so the engines'
+     * random choices are reproducible; what they see of each other through the incumbent and
+     * the budget still depends on timing.
+     */
+    class PortfolioAlgorithm : public Algorithm {
+    public:
+        struct EngineResult {
+            std::string name;
+            double cost;
+            double seconds; // Time at which the engine found its best cost
+            int runs;
+        };
+
+        /**
+         * @param time_limit Wall-clock budget in seconds; 0 lets every engine run to its own limits.
+         */
+        explicit PortfolioAlgorithm(double time_limit = 0.0) : time_limit(time_limit) {}
+
+        /**
+         * @brief Adds an engine. Engines must not be shared with another solve running at the same time.
+         * A solve replaces the engine's seed, warm start, incumbent and stop flag while it runs and
+         * gives the caller's back afterwards.
+         */
+        void addEngine(const std::string& name, std::shared_ptr<Algorithm> engine);
+
+        /**
+         * @brief Adds hill climbing, GRASP, simulated annealing, crow search, tabu search, VNS and the genetic algorithm.
+         */
+        void addDefaultEngines();
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+        /**
+         * @brief Name of the engine that found the solution returned by the last solve, or an empty
+         * string if none improved on the warm start or on an incumbent shared from outside.
+         */
+        std::string getWinner() const { return winner; }
+
+        /**
+         * @brief Best cost, time and number of runs of every engine in the last solve.
+         */
+        std::vector<EngineResult> getResults() const { return results; }
+
+    private:
+        double time_limit;
+        std::vector<std::pair<std::string, std::shared_ptr<Algorithm>>> engines;
+        mutable std::string winner;
+        mutable std::vector<EngineResult> results;
+    };
+}
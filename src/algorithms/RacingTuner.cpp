@@ -0,0 +1,248 @@
+#include "RacingTuner.hpp"
+#include "PortfolioAlgorithm.hpp"
+#include "../misc/Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace algorithm {
+
+    namespace {
+        /**
+         * @brief Ranks (1 = cheapest) of the given costs; costs within a relative 1e-9 of each other share their mean rank.
+         */
+        std::vector<double> rankCosts(const std::vector<double>& costs) {
+            std::vector<int> order(costs.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&costs](int a, int b) { return costs[a] < costs[b]; });
+
+            std::vector<double> ranks(costs.size());
+            std::size_t first = 0;
+            while (first < order.size()) {
+                double cost = costs[order[first]];
+                std::size_t last = first + 1;
+                while (last < order.size() && costs[order[last]] - cost <= 1e-9 * std::max(1.0, std::abs(cost))) {
+                    ++last;
+                }
+                double rank = (first + 1 + last) / 2.0;
+                for (std::size_t r = first; r < last; ++r) {
+                    ranks[order[r]] = rank;
+                }
+                first = last;
+            }
+            return ranks;
+        }
+
+        /**
+         * @brief 95% quantile of the chi-squared distribution (Wilson-Hilferty approximation).
+         */
+        double chiSquared95(int degrees_of_freedom) {
+            double d = degrees_of_freedom;
+            double t = 1.0 - 2.0 / (9.0 * d) + 1.6448536 * std::sqrt(2.0 / (9.0 * d));
+            return d * t * t * t;
+        }
+
+        /**
+         * @brief Critical value of the Nemenyi test at the 5% level for k configurations; k above 20 uses the k = 20 value.
+         */
+        double nemenyi95(int k) {
+            static const double q[] = { 0.0, 0.0, 1.960, 2.343, 2.569, 2.728, 2.850, 2.949, 3.031, 3.102, 3.164,
+                                        3.219, 3.268, 3.313, 3.354, 3.391, 3.426, 3.458, 3.489, 3.517, 3.544 };
+            return q[std::min(std::max(k, 2), 20)];
+        }
+    }
+
+    void RacingTuner::addConfiguration(const std::string& name, Factory factory) {
+        configurations.emplace_back(name, std::move(factory));
+    }
+
+    void RacingTuner::addInstance(const std::string& family, std::shared_ptr<const Problem> problem) {
+        families[family].push_back(std::move(problem));
+    }
+
+    std::vector<std::string> RacingTuner::getFamilies() const {
+        std::vector<std::string> names;
+        for (const auto& family : families) {
+            names.push_back(family.first);
+        }
+        return names;
+    }
+
+    RacingTuner::RaceResult RacingTuner::race(const std::string& family) const {
+        auto found = families.find(family);
+        if (found == families.end()) {
+            throw std::invalid_argument("Unknown instance family: " + family);
+        }
+        if (configurations.empty()) {
+            throw std::logic_error("The tuner has no configurations");
+        }
+
+        const std::vector<std::shared_ptr<const Problem>>& instances = found->second;
+        const int k = static_cast<int>(configurations.size());
+        const double not_run = std::numeric_limits<double>::quiet_NaN();
+        std::vector<std::vector<double>> costs(k, std::vector<double>(instances.size(), not_run));
+        std::vector<std::vector<double>> seconds(k, std::vector<double>(instances.size(), not_run));
+        std::vector<int> eliminated_after(k, -1);
+
+        auto aliveConfigurations = [&]() {
+            std::vector<int> alive;
+            for (int c = 0; c < k; ++c) {
+                if (eliminated_after[c] < 0) {
+                    alive.push_back(c);
+                }
+            }
+            return alive;
+        };
+
+        for (std::size_t b = 0; b < instances.size(); ++b) {
+            const Problem& problem = *instances[b];
+            std::vector<int> alive = aliveConfigurations();
+
+            // Run the survivors on this instance, a one-engine portfolio giving each run its budget
+            std::atomic<std::size_t> next(0);
+            std::mutex mutex;
+            std::exception_ptr failure;
+            auto worker = [&]() {
+                for (std::size_t slot = next++; slot < alive.size(); slot = next++) {
+                    int c = alive[slot];
+                    try {
+                        PortfolioAlgorithm run(time_limit);
+                        run.addEngine(configurations[c].first, configurations[c].second());
+                        run.solve(problem);
+                        costs[c][b] = run.getResults().front().cost;
+                        seconds[c][b] = run.getResults().front().seconds;
+                    }
+                    catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        failure = std::current_exception();
+                    }
+                }
+            };
+            int threads_to_use = number_of_threads > 0 ? number_of_threads : static_cast<int>(std::thread::hardware_concurrency());
+            threads_to_use = std::max(1, std::min(threads_to_use, static_cast<int>(alive.size())));
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threads_to_use; ++t) {
+                threads.emplace_back(worker);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+
+            int blocks = static_cast<int>(b) + 1;
+            int survivors = static_cast<int>(alive.size());
+            if (blocks < first_test || survivors < 2) {
+                continue;
+            }
+
+            // Friedman test over the blocks so far, ranking only the survivors
+            std::vector<double> mean_ranks(survivors, 0.0);
+            for (int block = 0; block < blocks; ++block) {
+                std::vector<double> block_costs;
+                for (int c : alive) {
+                    block_costs.push_back(costs[c][block]);
+                }
+                std::vector<double> ranks = rankCosts(block_costs);
+                for (int s = 0; s < survivors; ++s) {
+                    mean_ranks[s] += ranks[s] / blocks;
+                }
+            }
+            double statistic = 0.0;
+            for (double rank : mean_ranks) {
+                statistic += (rank - (survivors + 1) / 2.0) * (rank - (survivors + 1) / 2.0);
+            }
+            statistic *= 12.0 * blocks / (survivors * (survivors + 1.0));
+            if (statistic <= chiSquared95(survivors - 1)) {
+                continue;
+            }
+
+            double critical_difference = nemenyi95(survivors) * std::sqrt(survivors * (survivors + 1.0) / (6.0 * blocks));
+            double best_rank = *std::min_element(mean_ranks.begin(), mean_ranks.end());
+            for (int s = 0; s < survivors; ++s) {
+                if (mean_ranks[s] - best_rank > critical_difference) {
+                    eliminated_after[alive[s]] = blocks;
+                    UFLP_LOG_INFO("Race %s: dropped %s after %d instances (mean rank %.2f, best %.2f)", family.c_str(),
+                                  configurations[alive[s]].first.c_str(), blocks, mean_ranks[s], best_rank);
+                }
+            }
+        }
+
+        RaceResult result;
+        result.family = family;
+        std::vector<ConfigurationResult>& summaries = result.configurations;
+        for (int c = 0; c < k; ++c) {
+            summaries.push_back({ configurations[c].first, 0, 0.0, 0.0, 0.0, eliminated_after[c] });
+        }
+
+        // Ranks and gaps of every configuration on the instances it ran, among those that ran them
+        for (std::size_t b = 0; b < instances.size(); ++b) {
+            std::vector<int> ran;
+            std::vector<double> block_costs;
+            for (int c = 0; c < k; ++c) {
+                if (!std::isnan(costs[c][b])) {
+                    ran.push_back(c);
+                    block_costs.push_back(costs[c][b]);
+                }
+            }
+            if (ran.empty()) {
+                continue;
+            }
+            std::vector<double> ranks = rankCosts(block_costs);
+            double best = *std::min_element(block_costs.begin(), block_costs.end());
+            for (std::size_t r = 0; r < ran.size(); ++r) {
+                ConfigurationResult& summary = summaries[ran[r]];
+                ++summary.runs;
+                summary.mean_rank += ranks[r];
+                summary.mean_gap += (block_costs[r] - best) / std::max(1.0, std::abs(best));
+                summary.mean_seconds += seconds[ran[r]][b];
+            }
+        }
+        for (auto& summary : summaries) {
+            if (summary.runs > 0) {
+                summary.mean_rank /= summary.runs;
+                summary.mean_gap /= summary.runs;
+                summary.mean_seconds /= summary.runs;
+            }
+        }
+
+        // The winner is the surviving configuration with the best mean rank among the survivors
+        std::vector<int> alive = aliveConfigurations();
+        std::vector<double> final_ranks(alive.size(), 0.0);
+        for (std::size_t b = 0; b < instances.size(); ++b) {
+            std::vector<double> block_costs;
+            for (int c : alive) {
+                block_costs.push_back(costs[c][b]);
+            }
+            std::vector<double> ranks = rankCosts(block_costs);
+            for (std::size_t s = 0; s < alive.size(); ++s) {
+                final_ranks[s] += ranks[s];
+            }
+        }
+        std::size_t winner = 0;
+        for (std::size_t s = 1; s < alive.size(); ++s) {
+            if (final_ranks[s] < final_ranks[winner] ||
+                (final_ranks[s] == final_ranks[winner] && summaries[alive[s]].mean_seconds < summaries[alive[winner]].mean_seconds)) {
+                winner = s;
+            }
+        }
+        result.best = configurations[alive[winner]].first;
+        UFLP_LOG_INFO("Race %s: best configuration %s", family.c_str(), result.best.c_str());
+        return result;
+    }
+
+    std::vector<RacingTuner::RaceResult> RacingTuner::raceAll() const {
+        std::vector<RaceResult> results;
+        for (const auto& family : families) {
+            results.push_back(race(family.first));
+        }
+        return results;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Algorithm.hpp"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Racing (F-race) configuration of algorithm parameters over instance families.
+     *
+     * Every configuration is a named factory of a fully parameterised algorithm. A race runs the
+     * instances of one family in turn; on each instance the surviving configurations run in
+     * parallel and are ranked by cost. From the first_test-th instance on, a Friedman test over the
+     * ranks decides whether the survivors differ, and if so every configuration whose mean rank
+     * is worse than the best one by more than the Nemenyi critical difference (5% level) is dropped
+     * and not run again. The survivor with the best mean rank wins, the lower mean time breaking ties.
+     *
+     * Instances are added already parsed and shared by all runs of all races.
+     */
+    class RacingTuner {
+    public:
+        using Factory = std::function<std::shared_ptr<Algorithm>()>;
+
+        struct ConfigurationResult {
+            std::string name;
+            int runs;
+            double mean_rank;   // Over the instances it ran, among the configurations that ran them
+            double mean_gap;    // Relative gap to the best cost found on each instance
+            double mean_seconds;
+            int eliminated_after; // Instances run before it was dropped, or -1 if it survived
+        };
+
+        struct RaceResult {
+            std::string family;
+            std::string best;
+            std::vector<ConfigurationResult> configurations;
+        };
+
+        /**
+         * @param number_of_threads Concurrent runs; 0 uses the hardware concurrency.
+         * @param time_limit Budget of every run in seconds; 0 lets the algorithms run to their own limits.
+         * @param first_test Instances run before the first elimination test.
+         */
+        explicit RacingTuner(int number_of_threads = 0, double time_limit = 0.0, int first_test = 5)
+            : number_of_threads(number_of_threads), time_limit(time_limit), first_test(first_test) {}
+
+        void addConfiguration(const std::string& name, Factory factory);
+
+        /**
+         * @brief Adds an instance to a family. The problem is shared, not copied.
+         */
+        void addInstance(const std::string& family, std::shared_ptr<const Problem> problem);
+
+        std::vector<std::string> getFamilies() const;
+
+        /**
+         * @brief Races the configurations on one family. Throws std::invalid_argument for an unknown family
+         * and std::logic_error without configurations.
+         */
+        RaceResult race(const std::string& family) const;
+
+        /**
+         * @brief Races every family, in name order.
+         */
+        std::vector<RaceResult> raceAll() const;
+
+    private:
+        int number_of_threads;
+        double time_limit;
+        int first_test;
+        std::vector<std::pair<std::string, Factory>> configurations;
+        std::map<std::string, std::vector<std::shared_ptr<const Problem>>> families;
+    };
+}
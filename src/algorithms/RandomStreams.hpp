@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <random>
+
+namespace algorithm {
+
+    /**
+     * @brief Seed of one random stream of a solve, derived from the solve's master seed.
+     *
+     * Streams other than 0 go through splitmix64, so the streams of one seed, and the same
+     * stream of neighbouring seeds, are unrelated. Stream 0 is the master seed itself, so an
+     * algorithm that needs a single stream keeps the sequence its seed always gave.
+     */
+    inline std::uint64_t deriveSeed(std::uint64_t master_seed, std::uint64_t stream) {
+        if (stream == 0) {
+            return master_seed;
+        }
+        std::uint64_t z = master_seed + stream * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Seeds a 32-bit engine such as std::mt19937 from all 64 bits of a seed; its integer
+     * constructor keeps only the low 32, so seeds differing in the high half would coincide.
+     */
+    template <typename Engine>
+    void seedEngine(Engine& engine, std::uint64_t seed) {
+        std::seed_seq sequence{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+        engine.seed(sequence);
+    }
+}
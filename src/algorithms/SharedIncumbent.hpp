@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Best known open-facility set shared between concurrent searches.
+     *
+     * The cost sits in an atomic so that bound checks in hot loops are a single load.
+     * The open set itself is only touched under the mutex when a solution at least as
+     * good is offered or a copy is requested.
+     *
+     * Solutions of equal cost are ordered by their open sets, the lexicographically
+     * smallest one winning, so the incumbent does not depend on which of several threads
+     * offering them got there first.
+     *
+     * Every offer may name its source, usually the offering algorithm, so that whoever
+     * runs several searches against one incumbent can tell which of them set it.
+     */
+    class SharedIncumbent {
+    public:
+        SharedIncumbent() : cost(std::numeric_limits<double>::infinity()) {}
+
+        double getCost() const {
+            return cost.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Records the solution if it improves on the current one, or matches its cost
+         * with a lexicographically smaller open set.
+         *
+         * @param candidate_source Who found the solution; nullptr for none, e.g. a warm start.
+         * @return True if the solution became the new incumbent.
+         */
+        bool offer(double candidate_cost, const std::vector<bool>& candidate_open, const void* candidate_source = nullptr) {
+            if (candidate_cost > getCost()) {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            double current_cost = cost.load(std::memory_order_relaxed);
+            if (candidate_cost > current_cost || (candidate_cost == current_cost && !(candidate_open < open))) {
+                return false;
+            }
+            open = candidate_open;
+            source = candidate_source;
+            cost.store(candidate_cost, std::memory_order_release);
+            return true;
+        }
+
+        std::vector<bool> getOpenWarehouses() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return open;
+        }
+
+        /**
+         * @brief Source named by the offer that set the incumbent, or nullptr if none did.
+         */
+        const void* getSource() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return source;
+        }
+
+    private:
+        std::atomic<double> cost;
+        mutable std::mutex mutex;
+        std::vector<bool> open;
+        const void* source = nullptr;
+    };
+}
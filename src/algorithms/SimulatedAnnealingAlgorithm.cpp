@@ -1,7 +1,11 @@
 #include "SimulatedAnnealingAlgorithm.hpp"
+#include "IncrementalEvaluator.hpp"
+#include "Neighbourhood.hpp"
 #include <algorithm>
-#include <iostream>
+#include <cmath>
+#include <limits>
 #include <unordered_set>
+#include "../misc/Logger.hpp"
 
 /**
  * Calculates the total cost of the given assignment.
@@ -9,12 +13,11 @@
 double algorithm::SimulatedAnnealingAlgorithm::calculateCost(const std::vector<int>& assignment, const Problem& problem) const {
     double total_cost = 0.0;
     const auto& warehouses = problem.getWarehouses();
-    const auto& customers = problem.getCustomers();
     std::vector<bool> facilities_open(warehouses.size(), false);
 
     for (int j = 0; j < assignment.size(); ++j) {
         int warehouse_index = assignment[j];
-        total_cost += customers[j].getAllocationCosts()[warehouse_index];
+        total_cost += problem.getAllocationCost(j, warehouse_index);
         if (!facilities_open[warehouse_index]) {
             total_cost += warehouses[warehouse_index].getFixedCost();
             facilities_open[warehouse_index] = true;
@@ -24,11 +27,24 @@ double algorithm::SimulatedAnnealingAlgorithm::calculateCost(const std::vector<i
     return total_cost;
 }
 
+/**
+ * Picks a random warehouse for the customer: any warehouse, or one of its stored pairs on a sparse problem.
+ */
+int algorithm::SimulatedAnnealingAlgorithm::randomWarehouse(const Problem& problem, int customer, RandomGenerator& random) const {
+    if (const auto sparse = problem.getSparseCosts()) {
+        std::size_t row_length = sparse->rowEnd(customer) - sparse->rowBegin(customer);
+        if (row_length > 0) {
+            return sparse->getFacility(sparse->rowBegin(customer) + random.getRandomInt(static_cast<int>(row_length)));
+        }
+    }
+    return random.getRandomInt(problem.getNumberOfWarehouses());
+}
+
 /**
  * Generates a neighboring solution by randomly perturbing a small subset of the current solution.
  */
-algorithm::SimulatedAnnealingAlgorithm::Solution algorithm::SimulatedAnnealingAlgorithm::generateNeighbor(const Solution& current_solution, const Problem& problem) const {
-    RandomGenerator random;
+algorithm::SimulatedAnnealingAlgorithm::Solution algorithm::SimulatedAnnealingAlgorithm::generateNeighbor(const Solution& current_solution, const Problem& problem, const NearestFacilities& nearest,
+                                                                                                      RandomGenerator& random) const {
     Solution new_solution = current_solution;
 
     int num_perturbations = std::min(problem.getNumberOfCustomers() / 10, 25);
@@ -38,60 +54,185 @@ algorithm::SimulatedAnnealingAlgorithm::Solution algorithm::SimulatedAnnealingAl
     }
 
     for (int client : perturbed_customers) {
-        new_solution.assignment[client] = random.getRandomInt(problem.getNumberOfWarehouses());
+        new_solution.assignment[client] = randomWarehouse(problem, client, random);
     }
 
-    localSearch(new_solution, problem, 6);
+    localSearch(new_solution, problem, nearest);
     return new_solution;
 }
 
 /**
- * Performs a local search to refine the given solution using a tabu list to avoid cycles.
+ * Builds the candidate lists of the local search: the first entries of the sorted order or of the
+ * sparse rows, otherwise a partial sort of every customer's costs.
  */
-void algorithm::SimulatedAnnealingAlgorithm::localSearch(Solution& solution, const Problem& problem, int tabu_tenure) const {
+algorithm::NearestFacilities algorithm::NearestFacilities::build(const Problem& problem, int size) {
+    const int n = problem.getNumberOfCustomers();
+    const int m = problem.getNumberOfWarehouses();
+    NearestFacilities nearest;
+    nearest.offsets.reserve(n + 1);
+    nearest.offsets.push_back(0);
+
+    const auto sparse = problem.getSparseCosts();
+    const auto order = problem.getFacilityOrder();
+    std::vector<int> facilities(sparse ? 0 : m);
+    for (int j = 0; j < n; ++j) {
+        if (sparse) {
+            std::size_t end = std::min(sparse->rowEnd(j), sparse->rowBegin(j) + size);
+            for (std::size_t e = sparse->rowBegin(j); e < end; ++e) {
+                nearest.facilities.push_back(sparse->getFacility(e));
+                nearest.costs.push_back(sparse->getCost(e));
+            }
+        }
+        else {
+            const std::vector<double>& row = problem.getCustomers()[j].getAllocationCosts();
+            int count = std::min(size, m);
+            if (order) {
+                for (int r = 0; r < count; ++r) {
+                    facilities[r] = order->isNarrow() ? order->getNarrowRow(j)[r] : order->getWideRow(j)[r];
+                }
+            }
+            else {
+                for (int i = 0; i < m; ++i) {
+                    facilities[i] = i;
+                }
+                std::partial_sort(facilities.begin(), facilities.begin() + count, facilities.end(),
+                                  [&row](int a, int b) { return row[a] < row[b]; });
+            }
+            for (int r = 0; r < count; ++r) {
+                nearest.facilities.push_back(facilities[r]);
+                nearest.costs.push_back(row[facilities[r]]);
+            }
+        }
+        nearest.offsets.push_back(nearest.facilities.size());
+    }
+    return nearest;
+}
+
+/**
+ * First-improvement reassignment. Every pass offers each customer its nearest facilities and moves
+ * it to the best one that lowers the cost: moving customer j from a to b changes the cost by
+ * c(j, b) - c(j, a), plus b's fixed cost if b served no one, minus a's if j was its last customer.
+ * Single moves cannot empty a facility that serves several customers, so the pass then tries to
+ * close facilities, cheapest estimate first: every customer of a goes to its best other open
+ * facility, looked up among its nearest first, which saves a's fixed cost. A closure is priced exactly against the
+ * current counts when it is applied. Every move lowers the cost, so the search ends; max_passes bounds it.
+ */
+void algorithm::SimulatedAnnealingAlgorithm::localSearch(Solution& solution, const Problem& problem, const NearestFacilities& nearest, int max_passes) const {
     const auto& warehouses = problem.getWarehouses();
-    const auto& customers = problem.getCustomers();
-    std::unordered_set<int> tabu_list;
-    int iterations_without_improvement = 0;
-
-    while (iterations_without_improvement < 20) {
-        bool found_improvement = false;
-
-        for (int j = 0; j < customers.size(); ++j) {
-            int current_warehouse = solution.assignment[j];
-            double current_cost = customers[j].getAllocationCosts()[current_warehouse];
-            if (tabu_list.find(current_warehouse) == tabu_list.end()) {
-                current_cost += warehouses[current_warehouse].getFixedCost();
-            }
-
-            int best_warehouse = current_warehouse;
-            double best_cost = current_cost;
-
-            for (int i = 0; i < warehouses.size(); ++i) {
-                if (i != current_warehouse && tabu_list.find(i) == tabu_list.end()) {
-                    double new_cost = customers[j].getAllocationCosts()[i] + warehouses[i].getFixedCost();
-                    if (new_cost < best_cost) {
-                        best_warehouse = i;
-                        best_cost = new_cost;
-                        found_improvement = true;
-                    }
+    const int n = problem.getNumberOfCustomers();
+
+    std::vector<int> served(warehouses.size(), 0);
+    for (int warehouse : solution.assignment) {
+        ++served[warehouse];
+    }
+
+    // Customer j's cheapest open facility other than the one serving it, or -1. Its nearest facilities
+    // come first; only when none of them is open is its whole row scanned
+    const auto sparse = problem.getSparseCosts();
+    auto alternative = [&](int j, double& cost) {
+        int best = -1;
+        auto consider = [&](int i, double allocation_cost) {
+            if (i != solution.assignment[j] && served[i] > 0 && (best < 0 || allocation_cost < cost)) {
+                best = i;
+                cost = allocation_cost;
+            }
+        };
+        for (std::size_t e = nearest.offsets[j]; e < nearest.offsets[j + 1]; ++e) {
+            consider(nearest.facilities[e], nearest.costs[e]);
+        }
+        if (best < 0 && sparse) {
+            for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j); ++e) {
+                consider(sparse->getFacility(e), sparse->getCost(e));
+            }
+        }
+        else if (best < 0) {
+            const std::vector<double>& row = problem.getCustomers()[j].getAllocationCosts();
+            for (std::size_t i = 0; i < row.size(); ++i) {
+                consider(static_cast<int>(i), row[i]);
+            }
+        }
+        return best;
+    };
+    std::vector<std::vector<int>> customers_of(warehouses.size());
+    std::vector<std::pair<double, int>> closures;
+
+    for (int pass = 0; pass < max_passes; ++pass) {
+        bool improved = false;
+        for (int j = 0; j < n; ++j) {
+            const int current = solution.assignment[j];
+            const double current_cost = problem.getAllocationCost(j, current);
+            const double closing_gain = served[current] == 1 ? warehouses[current].getFixedCost() : 0.0;
+
+            int best_warehouse = current;
+            double best_delta = 0.0;
+            for (std::size_t e = nearest.offsets[j]; e < nearest.offsets[j + 1]; ++e) {
+                const int i = nearest.facilities[e];
+                if (i == current) {
+                    continue;
+                }
+                double delta = nearest.costs[e] - current_cost - closing_gain + (served[i] == 0 ? warehouses[i].getFixedCost() : 0.0);
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_warehouse = i;
                 }
             }
 
-            if (found_improvement) {
+            if (best_warehouse != current && best_delta < -1e-9 * std::max(1.0, std::abs(current_cost))) {
+                --served[current];
+                ++served[best_warehouse];
                 solution.assignment[j] = best_warehouse;
-                tabu_list.insert(best_warehouse);
-                if (tabu_list.size() > tabu_tenure) {
-                    tabu_list.erase(tabu_list.begin());
-                }
-                iterations_without_improvement = 0;
-            } else {
-                iterations_without_improvement++;
+                improved = true;
+            }
+        }
+
+        for (auto& customers : customers_of) {
+            customers.clear();
+        }
+        for (int j = 0; j < n; ++j) {
+            customers_of[solution.assignment[j]].push_back(j);
+        }
+        closures.clear();
+        for (std::size_t a = 0; a < warehouses.size(); ++a) {
+            double delta = -warehouses[a].getFixedCost();
+            for (int j : customers_of[a]) {
+                double cost;
+                delta = alternative(j, cost) < 0 ? std::numeric_limits<double>::infinity() : delta + cost - problem.getAllocationCost(j, static_cast<int>(a));
+            }
+            if (!customers_of[a].empty() && delta < 0) {
+                closures.emplace_back(delta, static_cast<int>(a));
             }
         }
+        std::sort(closures.begin(), closures.end());
 
-        if (!found_improvement) {
-            iterations_without_improvement++;
+        std::vector<int> targets;
+        for (const auto& closure : closures) {
+            const int a = closure.second;
+            if (static_cast<int>(customers_of[a].size()) != served[a]) {
+                continue; // Took customers from an earlier closure
+            }
+            double delta = -warehouses[a].getFixedCost();
+            targets.clear();
+            for (int j : customers_of[a]) {
+                double cost;
+                int target = alternative(j, cost);
+                if (target < 0) {
+                    delta = std::numeric_limits<double>::infinity();
+                    break;
+                }
+                targets.push_back(target);
+                delta += cost - problem.getAllocationCost(j, a);
+            }
+            if (delta < -1e-9 * std::max(1.0, warehouses[a].getFixedCost())) {
+                for (std::size_t k = 0; k < targets.size(); ++k) {
+                    solution.assignment[customers_of[a][k]] = targets[k];
+                    ++served[targets[k]];
+                }
+                served[a] = 0;
+                improved = true;
+            }
+        }
+        if (!improved) {
+            break;
         }
     }
 
@@ -101,8 +242,7 @@ void algorithm::SimulatedAnnealingAlgorithm::localSearch(Solution& solution, con
 /**
  * Generates a new solution by adaptively perturbing a portion of the current solution based on the iteration number.
  */
-algorithm::SimulatedAnnealingAlgorithm::Solution algorithm::SimulatedAnnealingAlgorithm::adaptivePerturbation(const Solution& current_solution, const Problem& problem, int iteration) const {
-    RandomGenerator random;
+algorithm::SimulatedAnnealingAlgorithm::Solution algorithm::SimulatedAnnealingAlgorithm::adaptivePerturbation(const Solution& current_solution, const Problem& problem, int iteration, RandomGenerator& random) const {
     Solution new_solution = current_solution;
 
     int num_customers = problem.getNumberOfCustomers();
@@ -114,55 +254,96 @@ algorithm::SimulatedAnnealingAlgorithm::Solution algorithm::SimulatedAnnealingAl
     }
 
     for (int client : perturbed_customers) {
-        new_solution.assignment[client] = random.getRandomInt(problem.getNumberOfWarehouses());
+        new_solution.assignment[client] = randomWarehouse(problem, client, random);
     }
 
     return new_solution;
 }
 
 /**
- * Solves the problem using the simulated annealing algorithm.
+ * Samples moves around the solution and sets the temperature at which their mean uphill cost change is accepted with probability 0.8.
+ */
+double algorithm::SimulatedAnnealingAlgorithm::calibrateTemperature(const Solution& solution, const Problem& problem, const NearestFacilities& nearest,
+                                                                      RandomGenerator& random) const {
+    const int samples = 20;
+    double uphill = 0.0;
+    int uphill_moves = 0;
+    for (int s = 0; s < samples; ++s) {
+        double delta = generateNeighbor(solution, problem, nearest, random).total_cost - solution.total_cost;
+        if (delta > 0) {
+            uphill += delta;
+            ++uphill_moves;
+        }
+    }
+    // With no uphill move sampled any temperature accepts them all; start at 1% of the cost
+    double mean_uphill = uphill_moves > 0 ? uphill / uphill_moves : 0.01 * solution.total_cost;
+    return -mean_uphill / std::log(0.8);
+}
+
+/**
+ * Solves the problem using the simulated annealing algorithm with geometric cooling.
  */
 std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::solve(const Problem& problem) const {
-    RandomGenerator random;
-    int num_warehouses = problem.getNumberOfWarehouses();
+    return anneal(problem, GeometricCooling(cooling_rate));
+}
+
+/**
+ * Runs a chain of iterations_per_temp moves at every temperature, from the initial one down to the final one under the schedule.
+ */
+template <typename Schedule>
+std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::anneal(const Problem& problem, Schedule schedule) const {
+    // One stream for the whole solve, so a seed replays the run
+    RandomGenerator random(streamSeed(0));
+    if (move_space == MoveSpace::Facilities) {
+        return annealFacilities(problem, schedule, random);
+    }
     int num_customers = problem.getNumberOfCustomers();
 
+    // Start from the warm start if there is one, otherwise from a random assignment
     Solution initial_solution;
-    initial_solution.assignment.resize(num_customers);
-    for (int j = 0; j < num_customers; ++j) {
-        initial_solution.assignment[j] = random.getRandomInt(num_warehouses);
+    initial_solution.assignment = getInitialAssignment(problem);
+    if (initial_solution.assignment.empty()) {
+        initial_solution.assignment.resize(num_customers);
+        for (int j = 0; j < num_customers; ++j) {
+            initial_solution.assignment[j] = randomWarehouse(problem, j, random);
+        }
     }
     initial_solution.total_cost = calculateCost(initial_solution.assignment, problem);
 
     Solution current_solution = initial_solution;
     Solution best_solution = current_solution;
+    const NearestFacilities nearest = NearestFacilities::build(problem, 10);
 
-    double temperature = initial_temperature;
+    double temperature = initial_temperature > 0 ? initial_temperature : calibrateTemperature(current_solution, problem, nearest, random);
+    UFLP_LOG_DEBUG("Simulated annealing from temperature %f to %f", temperature, final_temperature);
+    schedule.start(temperature, final_temperature);
     int iteration = 0;
 
-    while (temperature > final_temperature) {
-        for (int i = 0; i < iterations_per_temp; ++i) {
-            Solution new_solution = generateNeighbor(current_solution, problem);
-            new_solution.total_cost = calculateCost(new_solution.assignment, problem);
-            localSearch(new_solution, problem, 6);
+    while (temperature > final_temperature && !stopRequested()) {
+        ChainStatistics chain{ 0.0, false };
+        int moves = 0;
+        for (int i = 0; i < iterations_per_temp && !stopRequested(); ++i, ++moves) {
+            Solution new_solution = generateNeighbor(current_solution, problem, nearest, random);
 
             double delta_cost = new_solution.total_cost - current_solution.total_cost;
 
             if (delta_cost < 0 || std::exp(-delta_cost / temperature) > random.getRandom()) {
                 current_solution = new_solution;
+                chain.acceptance_rate += 1.0;
             }
 
             if (current_solution.total_cost < best_solution.total_cost) {
                 best_solution = current_solution;
-                std::cout << "New Best solution found: " << best_solution.total_cost << std::endl;
+                chain.improved = true;
+                UFLP_LOG_DEBUG("New Best solution found: %f", best_solution.total_cost);
             }
         }
+        chain.acceptance_rate /= std::max(1, moves);
 
-        temperature *= cooling_rate;
+        temperature = schedule.next(temperature, chain);
 
-        if (++iteration % 30 == 0) {
-            current_solution = adaptivePerturbation(best_solution, problem, iteration);
+        if (perturbation_period > 0 && ++iteration % perturbation_period == 0) {
+            current_solution = adaptivePerturbation(best_solution, problem, iteration, random);
             current_solution.total_cost = calculateCost(current_solution.assignment, problem);
         }
     }
@@ -174,3 +355,90 @@ std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::solve(c
 
     return result;
 }
+
+/**
+ * Anneals over open sets. A move flips a random facility; its cost change is the incremental
+ * evaluator's flip delta, and an accepted move is applied with one flip. Starts from the warm
+ * start or with every facility open, so a sparse problem starts feasible; an initial temperature
+ * of 0 or less is calibrated from the flip deltas of the start. A restart returns to the best
+ * open set and flips a tenth of the facilities. The best open set is quenched with a flip and
+ * swap descent at the end.
+ */
+template <typename Schedule>
+std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::annealFacilities(const Problem& problem, Schedule& schedule, RandomGenerator& random) const {
+    const int m = problem.getNumberOfWarehouses();
+    IncrementalEvaluator evaluator(problem);
+    std::vector<bool> start = getInitialOpenSet(problem);
+    evaluator.reset(start.empty() ? std::vector<bool>(m, true) : start);
+
+    double temperature = initial_temperature;
+    if (temperature <= 0) {
+        std::vector<double> deltas;
+        evaluator.computeFlipDeltas(deltas);
+        double uphill = 0.0;
+        int uphill_moves = 0;
+        for (double delta : deltas) {
+            if (delta > 0 && std::isfinite(delta)) {
+                uphill += delta;
+                ++uphill_moves;
+            }
+        }
+        double mean_uphill = uphill_moves > 0 ? uphill / uphill_moves : 0.01 * evaluator.getCost();
+        temperature = -mean_uphill / std::log(0.8);
+    }
+    UFLP_LOG_DEBUG("Facility simulated annealing from temperature %f to %f", temperature, final_temperature);
+    schedule.start(temperature, final_temperature);
+
+    std::vector<bool> best_open = evaluator.getOpenWarehouses();
+    double best_cost = evaluator.getCost();
+    int iteration = 0;
+
+    while (temperature > final_temperature && !stopRequested()) {
+        ChainStatistics chain{ 0.0, false };
+        int moves = 0;
+        for (int i = 0; i < iterations_per_temp && !stopRequested(); ++i, ++moves) {
+            int facility = random.getRandomInt(m);
+            double delta_cost = evaluator.flipDelta(facility);
+            if (delta_cost < 0 || std::exp(-delta_cost / temperature) > random.getRandom()) {
+                evaluator.flip(facility);
+                chain.acceptance_rate += 1.0;
+
+                if (evaluator.getCost() < best_cost) {
+                    best_cost = evaluator.getCost();
+                    best_open = evaluator.getOpenWarehouses();
+                    chain.improved = true;
+                    UFLP_LOG_DEBUG("New Best solution found: %f", best_cost);
+                }
+            }
+        }
+        chain.acceptance_rate /= std::max(1, moves);
+
+        temperature = schedule.next(temperature, chain);
+
+        if (perturbation_period > 0 && ++iteration % perturbation_period == 0) {
+            evaluator.reset(best_open);
+            for (int k = 0; k < std::max(1, m / 10); ++k) {
+                int facility = random.getRandomInt(m);
+                if (std::isfinite(evaluator.flipDelta(facility))) {
+                    evaluator.flip(facility);
+                }
+            }
+        }
+    }
+
+    // Quench: descend from the best open set to a flip and swap local optimum
+    evaluator.reset(best_open);
+    FlipNeighbourhood flip;
+    SwapNeighbourhood swap(evaluator);
+    variableNeighbourhoodDescent(evaluator, { &flip, &swap });
+
+    offerIncumbent(evaluator.getCost(), evaluator.getOpenWarehouses());
+    return evaluator.getAssignments();
+}
+
+template std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::anneal(const Problem&, GeometricCooling) const;
+template std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::anneal(const Problem&, LundyMeesCooling) const;
+template std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::anneal(const Problem&, AdaptiveCooling) const;
+template std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::anneal(const Problem&, Reheating<GeometricCooling>) const;
+template std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::anneal(const Problem&, Reheating<LundyMeesCooling>) const;
+template std::vector<std::pair<int, int>> algorithm::SimulatedAnnealingAlgorithm::anneal(const Problem&, Reheating<AdaptiveCooling>) const;
@@ -4,39 +4,229 @@
 
 #ifndef SIMULATEDANNEALINGALGORITHM_H
 #define SIMULATEDANNEALINGALGORITHM_H
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 #include <random>
 #include "../problem/Problem.hpp"
+#include "Algorithm.hpp"
 class Problem;
 namespace algorithm {
 
-        class SimulatedAnnealingAlgorithm {
+        /**
+         * @brief What a cooling schedule sees of the chain just run at the current temperature.
+         */
+        struct ChainStatistics {
+            double acceptance_rate;
+            bool improved; // The chain found a new best solution
+        };
+
+        // Cooling schedules are template policies of the annealing loop, so choosing one costs no
+        // dispatch. A schedule has start(initial_temperature, final_temperature), called once the
+        // initial temperature is known, and next(temperature, chain), which returns the temperature
+        // of the next chain. Annealing ends once the temperature is at most the final one.
+
+        /**
+         * @brief T <- cooling_rate * T.
+         */
+        struct GeometricCooling {
+            explicit GeometricCooling(double cooling_rate) : cooling_rate(cooling_rate) {}
+
+            void start(double, double) {}
+
+            double next(double temperature, const ChainStatistics&) const {
+                return temperature * cooling_rate;
+            }
+
+            double cooling_rate;
+        };
+
+        /**
+         * @brief Lundy-Mees: T <- T / (1 + beta * T), with beta set so that the final temperature is
+         * reached after the given number of chains. Cools fast while hot and slowly near the end.
+         */
+        struct LundyMeesCooling {
+            explicit LundyMeesCooling(int steps) : steps(std::max(1, steps)), beta(0.0) {}
+
+            void start(double initial_temperature, double final_temperature) {
+                beta = (initial_temperature - final_temperature) / (steps * initial_temperature * final_temperature);
+            }
+
+            double next(double temperature, const ChainStatistics&) const {
+                return temperature / (1.0 + beta * temperature);
+            }
+
+            int steps;
+            double beta;
+        };
+
+        /**
+         * @brief Geometric cooling whose rate follows the acceptance rate: while more moves than the
+         * target are accepted the temperature is too high and falls faster (up to cooling_rate^2 per
+         * chain), while fewer are accepted it falls slower (down to cooling_rate^0.5).
+         */
+        struct AdaptiveCooling {
+            explicit AdaptiveCooling(double cooling_rate, double target_acceptance = 0.3)
+                : cooling_rate(cooling_rate), target_acceptance(target_acceptance) {}
+
+            void start(double, double) {}
+
+            double next(double temperature, const ChainStatistics& chain) const {
+                double exponent = std::min(2.0, std::max(0.5, chain.acceptance_rate / target_acceptance));
+                return temperature * std::pow(cooling_rate, exponent);
+            }
+
+            double cooling_rate;
+            double target_acceptance;
+        };
+
+        /**
+         * @brief Adds reheating to another schedule: after patience chains without a new best, the
+         * temperature goes back up to fraction of the initial one, at most max_reheats times.
+         */
+        template <typename Cooling>
+        struct Reheating {
+            Reheating(const Cooling& cooling, int patience, double fraction = 0.5, int max_reheats = 5)
+                : cooling(cooling), patience(patience), fraction(fraction), max_reheats(max_reheats) {}
+
+            void start(double initial_temperature, double final_temperature) {
+                cooling.start(initial_temperature, final_temperature);
+                initial = initial_temperature;
+                stale = 0;
+                reheats = 0;
+            }
+
+            double next(double temperature, const ChainStatistics& chain) {
+                stale = chain.improved ? 0 : stale + 1;
+                if (stale >= patience && reheats < max_reheats) {
+                    stale = 0;
+                    ++reheats;
+                    return std::max(temperature, fraction * initial);
+                }
+                return cooling.next(temperature, chain);
+            }
+
+            Cooling cooling;
+            int patience;
+            double fraction;
+            int max_reheats;
+            double initial = 0.0;
+            int stale = 0;
+            int reheats = 0;
+        };
+
+        /**
+         * @brief The cheapest facilities of every customer, with their costs; customer j's are [offsets[j], offsets[j + 1]).
+         */
+        struct NearestFacilities {
+            std::vector<int> facilities;
+            std::vector<double> costs;
+            std::vector<std::size_t> offsets;
+
+            /**
+             * @brief The size cheapest facilities of every customer, from the sorted order or the sparse rows when available.
+             */
+            static NearestFacilities build(const Problem& problem, int size);
+        };
+
+        class SimulatedAnnealingAlgorithm : public Algorithm {
         public:
+            /**
+             * @brief Customers: a move sends some customers to random warehouses and is polished by a local search.
+             * Facilities: a move flips one facility, customers follow their nearest open facility and the
+             * cost change comes from the incremental evaluator, so a move costs about as much as one flip.
+             */
+            enum class MoveSpace { Customers, Facilities };
+
             struct Solution {
                 std::vector<int> assignment;
                 double total_cost = 0.0;
             };
 
-            SimulatedAnnealingAlgorithm(double initial_temperature, double final_temperature, double cooling_rate, int iterations_per_temp)
-                : initial_temperature(initial_temperature), final_temperature(final_temperature), cooling_rate(cooling_rate), iterations_per_temp(iterations_per_temp) {}
+            /**
+             * @brief Geometric cooling from initial_temperature to final_temperature.
+             *
+             * @param initial_temperature Starting temperature; 0 or less calibrates it from sampled moves.
+             * @param perturbation_period Temperature steps between restarts from a perturbed best solution; 0 never restarts.
+             */
+            SimulatedAnnealingAlgorithm(double initial_temperature, double final_temperature, double cooling_rate, int iterations_per_temp,
+                                        int perturbation_period = 30, MoveSpace move_space = MoveSpace::Customers)
+                : initial_temperature(initial_temperature), final_temperature(final_temperature), cooling_rate(cooling_rate), iterations_per_temp(iterations_per_temp),
+                  perturbation_period(perturbation_period), move_space(move_space) {}
+
+            std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
 
-            std::vector<std::pair<int, int>> solve(const Problem& problem) const;
+        protected:
+            /**
+             * @brief The annealing loop under the given cooling schedule. Instantiated for the schedules
+             * in this header, Reheating of each included.
+             */
+            template <typename Schedule>
+            std::vector<std::pair<int, int>> anneal(const Problem& problem, Schedule schedule) const;
 
         private:
+            /**
+             * @brief anneal over open sets, for MoveSpace::Facilities.
+             */
+            template <typename Schedule>
+            std::vector<std::pair<int, int>> annealFacilities(const Problem& problem, Schedule& schedule, class RandomGenerator& random) const;
+
+            /**
+             * @brief Initial temperature at which an average uphill move is accepted with probability 0.8,
+             * from the cost changes of moves sampled around the solution.
+             */
+            double calibrateTemperature(const Solution& solution, const Problem& problem, const NearestFacilities& nearest, class RandomGenerator& random) const;
+
             double calculateCost(const std::vector<int>& assignment, const Problem& problem) const;
-            Solution generateNeighbor(const Solution& current_solution, const Problem& problem) const;
-            void localSearch(Solution& solution, const Problem& problem, int tabu_tenure) const;
-            Solution adaptivePerturbation(const Solution& current_solution, const Problem& problem, int iteration) const;
+            int randomWarehouse(const Problem& problem, int customer, class RandomGenerator& random) const;
+            Solution generateNeighbor(const Solution& current_solution, const Problem& problem, const NearestFacilities& nearest,
+                                      class RandomGenerator& random) const;
+
+            /**
+             * @brief Moves single customers to cheaper facilities among their nearest ones until no move
+             * improves the cost, for at most max_passes passes. A move's gain includes the fixed costs it
+             * saves or adds, from the number of customers each facility serves.
+             */
+            void localSearch(Solution& solution, const Problem& problem, const NearestFacilities& nearest, int max_passes = 50) const;
+            Solution adaptivePerturbation(const Solution& current_solution, const Problem& problem, int iteration, class RandomGenerator& random) const;
 
             double initial_temperature;
             double final_temperature;
             double cooling_rate;
             int iterations_per_temp;
+            int perturbation_period;
+            MoveSpace move_space;
+        };
+
+        /**
+         * @brief Simulated annealing with a cooling schedule chosen at compile time, e.g.
+         * ScheduledSimulatedAnnealing<Reheating<AdaptiveCooling>>.
+         */
+        template <typename Schedule>
+        class ScheduledSimulatedAnnealing : public SimulatedAnnealingAlgorithm {
+        public:
+            /**
+             * @param initial_temperature Starting temperature; 0 or less calibrates it from sampled moves.
+             */
+            ScheduledSimulatedAnnealing(const Schedule& schedule, double initial_temperature, double final_temperature, int iterations_per_temp,
+                                        int perturbation_period = 30, MoveSpace move_space = MoveSpace::Customers)
+                : SimulatedAnnealingAlgorithm(initial_temperature, final_temperature, 1.0, iterations_per_temp, perturbation_period, move_space),
+                  schedule(schedule) {}
+
+            std::vector<std::pair<int, int>> solve(const Problem& problem) const override {
+                return anneal(problem, schedule);
+            }
+
+        private:
+            Schedule schedule;
         };
 
         class RandomGenerator {
         public:
-            RandomGenerator() : rng(std::random_device{}()), dist(0.0, 1.0) {}
+            explicit RandomGenerator(std::uint64_t seed) : dist(0.0, 1.0) {
+                seedEngine(rng, seed);
+            }
 
             double getRandom() {
                 return dist(rng);
@@ -0,0 +1,96 @@
+#include "TabuSearchAlgorithm.hpp"
+#include "ElitePool.hpp"
+#include "IncrementalEvaluator.hpp"
+#include "../misc/Logger.hpp"
+#include <limits>
+#include <random>
+
+namespace algorithm {
+
+    /**
+     * @brief Solves the problem with tabu search, starting from every facility open.
+     *
+     * @param problem The problem instance to solve.
+     * @return A vector of pairs representing the assignment of customers to warehouses.
+     *
+     * The tenure of each move is drawn from [tenure, tenure + tenure / 2] to break cycles.
+     * When every move is tabu and none passes aspiration, the move whose tabu status expires
+     * first is taken. The search stops after max_iterations iterations or after
+     * max_iterations_without_improvement iterations without a new best.
+     */
+    std::vector<std::pair<int, int>> TabuSearchAlgorithm::solve(const Problem& problem) const {
+        const int number_of_warehouses = problem.getNumberOfWarehouses();
+        const double EPSILON = 1e-9;
+
+        std::vector<bool> start = getInitialOpenSet(problem);
+        if (start.empty()) {
+            start.assign(number_of_warehouses, true);
+        }
+
+        IncrementalEvaluator evaluator(problem);
+        evaluator.reset(start);
+
+        std::mt19937 generator;
+        seedEngine(generator, streamSeed(0));
+        std::uniform_int_distribution<int> jitter(0, tenure / 2);
+
+        std::vector<long long> tabu_until(number_of_warehouses, 0);
+        std::vector<double> deltas;
+
+        std::vector<bool> best_open = evaluator.getOpenWarehouses();
+        double best_cost = evaluator.getCost();
+        int iterations_without_improvement = 0;
+
+        for (long long iteration = 1; iteration <= max_iterations && !stopRequested(); ++iteration) {
+            evaluator.computeFlipDeltas(deltas);
+
+            int chosen = -1;
+            double chosen_delta = std::numeric_limits<double>::infinity();
+            int oldest = -1;
+
+            for (int i = 0; i < number_of_warehouses; ++i) {
+                if (deltas[i] == std::numeric_limits<double>::infinity()) {
+                    continue;
+                }
+
+                bool is_tabu = tabu_until[i] >= iteration;
+                bool aspiration = evaluator.getCost() + deltas[i] < best_cost - EPSILON;
+
+                if ((!is_tabu || aspiration) && deltas[i] < chosen_delta) {
+                    chosen = i;
+                    chosen_delta = deltas[i];
+                }
+                if (oldest == -1 || tabu_until[i] < tabu_until[oldest]) {
+                    oldest = i;
+                }
+            }
+
+            if (chosen == -1) {
+                chosen = oldest;
+            }
+            if (chosen == -1) {
+                break;
+            }
+
+            evaluator.flip(chosen);
+            tabu_until[chosen] = iteration + tenure + jitter(generator);
+
+            if (evaluator.getCost() < best_cost - EPSILON) {
+                best_cost = evaluator.getCost();
+                best_open = evaluator.getOpenWarehouses();
+                iterations_without_improvement = 0;
+                UFLP_LOG_DEBUG("Tabu iteration %lld: new best %f", iteration, best_cost);
+                if (elite_pool) {
+                    elite_pool->add(best_open, best_cost);
+                }
+                offerIncumbent(best_cost, best_open);
+            }
+            else if (++iterations_without_improvement >= max_iterations_without_improvement) {
+                break;
+            }
+        }
+
+        evaluator.reset(best_open);
+        return evaluator.getAssignments();
+    }
+}
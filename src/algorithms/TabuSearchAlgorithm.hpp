@@ -0,0 +1,30 @@
+#pragma once
+#include "Algorithm.hpp"
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Tabu search over facility flips.
+     *
+     * Each iteration prices every flip with the incremental evaluator and applies the best
+     * admissible one. A facility that was just flipped stays tabu until the iteration stamped
+     * in its tabu_until slot, so the tabu check is a single array read. A tabu flip is still
+     * allowed when it would improve on the best cost found so far (aspiration).
+     */
+    class TabuSearchAlgorithm : public Algorithm {
+    public:
+        TabuSearchAlgorithm(int max_iterations, int tenure, int max_iterations_without_improvement, unsigned int seed = 0)
+            : max_iterations(max_iterations), tenure(tenure),
+              max_iterations_without_improvement(max_iterations_without_improvement) {
+            setSeed(seed);
+        }
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+    private:
+        int max_iterations;
+        int tenure;
+        int max_iterations_without_improvement;
+    };
+}
@@ -0,0 +1,63 @@
+#include "VariableNeighbourhoodSearch.hpp"
+#include "ElitePool.hpp"
+#include "IncrementalEvaluator.hpp"
+#include "Neighbourhood.hpp"
+#include "../misc/Logger.hpp"
+#include <random>
+
+namespace algorithm {
+
+    /**
+     * @brief Solves the problem with VNS, starting from the warm start or from every facility open.
+     *
+     * @param problem The problem instance to solve.
+     * @return A vector of pairs representing the assignment of customers to warehouses.
+     *
+     * One iteration is one shake followed by one descent; the search stops after max_iterations.
+     */
+    std::vector<std::pair<int, int>> VariableNeighbourhoodSearch::solve(const Problem& problem) const {
+        std::vector<bool> start = getInitialOpenSet(problem);
+        if (start.empty()) {
+            start.assign(problem.getNumberOfWarehouses(), true);
+        }
+
+        IncrementalEvaluator evaluator(problem);
+        evaluator.reset(start);
+
+        FlipNeighbourhood flip;
+        SwapNeighbourhood swap(evaluator);
+        MultiSwapNeighbourhood shaker(evaluator, candidate_list_size);
+        std::vector<Neighbourhood*> neighbourhoods = { &flip, &swap };
+
+        std::mt19937 generator;
+        seedEngine(generator, streamSeed(0));
+
+        variableNeighbourhoodDescent(evaluator, neighbourhoods);
+        std::vector<bool> best_open = evaluator.getOpenWarehouses();
+        double best_cost = evaluator.getCost();
+
+        int k = 1;
+        for (int iteration = 0; iteration < max_iterations && !stopRequested(); ++iteration) {
+            evaluator.reset(best_open);
+            shaker.shake(evaluator, k, generator);
+            variableNeighbourhoodDescent(evaluator, neighbourhoods);
+            if (elite_pool) {
+                elite_pool->add(evaluator.getOpenWarehouses(), evaluator.getCost());
+            }
+
+            if (evaluator.getCost() < best_cost - 1e-9 * best_cost) {
+                best_cost = evaluator.getCost();
+                best_open = evaluator.getOpenWarehouses();
+                k = 1;
+                UFLP_LOG_DEBUG("VNS iteration %d: new best %f", iteration, best_cost);
+                offerIncumbent(best_cost, best_open);
+            }
+            else {
+                k = k < k_max ? k + 1 : 1;
+            }
+        }
+
+        evaluator.reset(best_open);
+        return evaluator.getAssignments();
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "Algorithm.hpp"
+#include <vector>
+
+namespace algorithm {
+
+    /**
+     * @brief Variable neighbourhood search over facility space.
+     *
+     * The local search is a variable neighbourhood descent over the flip and swap
+     * neighbourhoods. Shaking applies k random swaps drawn from the facilities' candidate
+     * lists. k grows from 1 to k_max while shaking fails to improve and resets to 1
+     * after every improvement.
+     */
+    class VariableNeighbourhoodSearch : public Algorithm {
+    public:
+        VariableNeighbourhoodSearch(int k_max, int max_iterations, int candidate_list_size = 10, unsigned int seed = 0)
+            : k_max(k_max), max_iterations(max_iterations), candidate_list_size(candidate_list_size) {
+            setSeed(seed);
+        }
+
+        std::vector<std::pair<int, int>> solve(const Problem& problem) const override;
+
+    private:
+        int k_max;
+        int max_iterations;
+        int candidate_list_size;
+    };
+}
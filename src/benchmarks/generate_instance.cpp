@@ -0,0 +1,46 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include "../misc/InstanceGenerator.hpp"
+
+/**
+ * Writes one synthetic instance.
+ *
+ * Usage: generate_instance <euclidean|clustered|kcapm> <customers> <warehouses> <seed> <path> [orlib|m]
+ */
+int main(int argc, char** argv) {
+	if (argc < 6) {
+		std::fprintf(stderr, "Usage: %s <euclidean|clustered|kcapm> <customers> <warehouses> <seed> <path> [orlib|m]\n", argv[0]);
+		return 1;
+	}
+
+	miscellaneous::GeneratorSettings settings;
+	if (std::strcmp(argv[1], "clustered") == 0) {
+		settings.family = miscellaneous::InstanceFamily::Clustered;
+	}
+	else if (std::strcmp(argv[1], "kcapm") == 0) {
+		settings.family = miscellaneous::InstanceFamily::KcapmRandom;
+	}
+	settings.number_of_customers = std::atoi(argv[2]);
+	settings.number_of_warehouses = std::atoi(argv[3]);
+	settings.seed = std::strtoull(argv[4], nullptr, 10);
+
+	bool m_format = argc > 6 ? std::strcmp(argv[6], "m") == 0 : settings.family == miscellaneous::InstanceFamily::KcapmRandom;
+
+	try {
+		Problem problem = miscellaneous::InstanceGenerator::generate(settings);
+		if (m_format) {
+			miscellaneous::InstanceGenerator::writeM(problem, argv[5]);
+		}
+		else {
+			miscellaneous::InstanceGenerator::writeORLib(problem, argv[5]);
+		}
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "Error generating instance: %s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
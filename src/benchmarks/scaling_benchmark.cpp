@@ -0,0 +1,154 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../misc/InstanceGenerator.hpp"
+#include "../problem/Problem.hpp"
+#include "../algorithms/IncrementalEvaluator.hpp"
+#include "../algorithms/Neighbourhood.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Sweeps synthetic instances over every (customers, warehouses) pair of the size list and prints
+ * one CSV row per pair: time per full evaluation (scan and sorted walk), time per flip and swap
+ * neighbourhood pass, and the peak resident memory of that pair. The *_ns_per_cell columns divide
+ * by n * m, so a super-linear regression shows up as a column that grows along the sweep.
+ *
+ * On Unix every pair runs in its own child process, whose peak resident set covers that pair
+ * alone; where that is not possible the pair runs in this process and peak_rss_mb is -1.
+ *
+ * With --nearest K the instances are generated sparse, keeping each customer's K cheapest
+ * facilities; the sorted walk is then the sparse row walk itself, so walk_ms repeats scan_ms.
+ *
+ * Usage: scaling_benchmark [euclidean|clustered|kcapm] [--nearest K] [size ...]
+ */
+
+namespace {
+	/**
+	 * @brief Peak resident set of this process so far in MiB, or -1 where it is not available.
+	 */
+	double peakMemoryMegabytes() {
+#if defined(__unix__) || defined(__APPLE__)
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+		return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+		return usage.ru_maxrss / 1024.0;
+#endif
+#else
+		return -1.0;
+#endif
+	}
+
+	/**
+	 * @brief Average milliseconds per call of work, repeated until at least 0.2 s have passed.
+	 */
+	template <typename Work>
+	double timePerCall(Work work) {
+		using clock = std::chrono::steady_clock;
+		int calls = 0;
+		auto start = clock::now();
+		double elapsed = 0.0;
+		do {
+			work(calls++);
+			elapsed = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		} while (elapsed < 200.0);
+		return elapsed / calls;
+	}
+
+	/**
+	 * @brief Generates one instance of n customers and m warehouses, times it and prints its row.
+	 * The peak memory is only reported when the process ran nothing else (alone), else it is -1.
+	 */
+	void benchmarkSize(miscellaneous::GeneratorSettings settings, int n, int m, bool alone) {
+		settings.number_of_customers = n;
+		settings.number_of_warehouses = m;
+		Problem problem = miscellaneous::InstanceGenerator::generate(settings);
+		problem.buildFacilityOrder();
+
+		// A tenth of the facilities open, the usual regime of a local search
+		std::vector<std::vector<bool>> open_sets(16, std::vector<bool>(m, false));
+		for (int s = 0; s < 16; ++s) {
+			for (int i = s; i < m; i += 10) {
+				open_sets[s][i] = true;
+			}
+		}
+
+		std::shared_ptr<const CostMatrix> costs = problem.getSearchCosts();
+		std::shared_ptr<const FacilityOrder> order = problem.getFacilityOrder();
+		volatile double sink = 0.0;
+
+		double scan_ms = timePerCall([&](int call) { sink = sink + costs->evaluate(open_sets[call % 16]); });
+		double walk_ms = order ? timePerCall([&](int call) { sink = sink + costs->evaluate(open_sets[call % 16], *order); }) : scan_ms;
+
+		algorithm::IncrementalEvaluator evaluator(problem);
+		evaluator.reset(open_sets[0]);
+		algorithm::FlipNeighbourhood flip;
+		algorithm::SwapNeighbourhood swap(evaluator);
+		double flip_ms = timePerCall([&](int) { sink = sink + flip.findBestMove(evaluator).delta; });
+		double swap_ms = timePerCall([&](int) { sink = sink + swap.findBestMove(evaluator).delta; });
+
+		double cells = static_cast<double>(n) * m;
+		double peak_memory = alone ? peakMemoryMegabytes() : -1.0;
+		std::printf("%d,%d,%.4f,%.3f,%.4f,%.4f,%.3f,%.4f,%.3f,%.1f\n", n, m, scan_ms, scan_ms * 1e6 / cells, walk_ms,
+					flip_ms, flip_ms * 1e6 / cells, swap_ms, swap_ms * 1e6 / cells, peak_memory);
+		std::fflush(stdout);
+	}
+
+	/**
+	 * @brief Runs benchmarkSize in a child process, so its peak memory is not the sweep's so far.
+	 * Returns false if the child failed.
+	 */
+	bool benchmarkSizeAlone(const miscellaneous::GeneratorSettings& settings, int n, int m) {
+#if defined(__unix__) || defined(__APPLE__)
+		std::fflush(stdout);
+		pid_t child = fork();
+		if (child == 0) {
+			benchmarkSize(settings, n, m, true);
+			_exit(0);
+		}
+		if (child > 0) {
+			int status = 0;
+			return waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+		}
+#endif
+		benchmarkSize(settings, n, m, false);
+		return true;
+	}
+}
+
+int main(int argc, char** argv) {
+	miscellaneous::GeneratorSettings settings;
+	std::vector<int> sizes;
+
+	for (int a = 1; a < argc; ++a) {
+		if (std::strcmp(argv[a], "euclidean") == 0) settings.family = miscellaneous::InstanceFamily::Euclidean;
+		else if (std::strcmp(argv[a], "clustered") == 0) settings.family = miscellaneous::InstanceFamily::Clustered;
+		else if (std::strcmp(argv[a], "kcapm") == 0) settings.family = miscellaneous::InstanceFamily::KcapmRandom;
+		else if (std::strcmp(argv[a], "--nearest") == 0 && a + 1 < argc) settings.nearest_facilities = std::atoi(argv[++a]);
+		else sizes.push_back(std::atoi(argv[a]));
+	}
+	if (sizes.empty()) {
+		sizes = { 250, 500, 1000, 2000 };
+	}
+
+	std::printf("customers,warehouses,scan_ms,scan_ns_per_cell,walk_ms,flip_pass_ms,flip_ns_per_cell,swap_pass_ms,swap_ns_per_cell,peak_rss_mb\n");
+
+	for (int n : sizes) {
+		for (int m : sizes) {
+			if (!benchmarkSizeAlone(settings, n, m)) {
+				std::fprintf(stderr, "Benchmark of %d customers and %d warehouses failed\n", n, m);
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <string>
+#include "../misc/MParser.hpp"
+#include "../misc/ORLibParser.hpp"
+#include "../algorithms/AlgorithmSelector.hpp"
+
+/**
+ * Runs every default selector candidate on every instance and writes the observations as the
+ * CSV that AlgorithmSelector::load reads. An existing output file is extended, so instance sets
+ * can be added over several runs; if it cannot be parsed, nothing is run or written. Instances
+ * are read in the ORLib format, or in the M format after --m.
+ *
+ * Usage: selector_training <output.csv> [--time-limit S] [--orlib|--m] instance ...
+ */
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		std::fprintf(stderr, "Usage: %s <output.csv> [--time-limit S] [--orlib|--m] instance ...\n", argv[0]);
+		return 1;
+	}
+
+	algorithm::AlgorithmSelector selector;
+	selector.addDefaultCandidates();
+	const std::string output = argv[1];
+
+	double time_limit = 0.0;
+	bool m_format = false;
+	miscellaneous::ORLibParser orlib_parser;
+	miscellaneous::MParser m_parser;
+
+	try {
+		// A missing output file means no previous observations; a malformed one stops the run
+		// before save() could overwrite it
+		if (std::ifstream(output)) {
+			selector.load(output);
+		}
+
+		for (int a = 2; a < argc; ++a) {
+			if (std::strcmp(argv[a], "--time-limit") == 0 && a + 1 < argc) {
+				time_limit = std::atof(argv[++a]);
+			}
+			else if (std::strcmp(argv[a], "--orlib") == 0) {
+				m_format = false;
+			}
+			else if (std::strcmp(argv[a], "--m") == 0) {
+				m_format = true;
+			}
+			else {
+				Problem problem = m_format ? m_parser.parse(argv[a]) : orlib_parser.parse(argv[a]);
+				selector.train(problem, time_limit);
+				selector.save(output);
+				std::printf("%s done\n", argv[a]);
+				std::fflush(stdout);
+			}
+		}
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
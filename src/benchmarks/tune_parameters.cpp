@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "../misc/MParser.hpp"
+#include "../misc/ORLibParser.hpp"
+#include "../algorithms/CrowSearchAlgorithm.hpp"
+#include "../algorithms/GRASP.hpp"
+#include "../algorithms/RacingTuner.hpp"
+#include "../algorithms/SimulatedAnnealingAlgorithm.hpp"
+
+/**
+ * Races a parameter grid of GRASP (alpha), simulated annealing (initial temperature, cooling rate,
+ * iterations per temperature) or crow search (population, awareness probability) over instance
+ * families and prints one CSV row per family and configuration; the best column marks the
+ * configuration to use on that family. Every instance is parsed once. An instance belongs to the
+ * family named by the last --family, or by its directory if there was none; instances are read
+ * in the ORLib format, or in the M format after --m.
+ *
+ * Usage: tune_parameters <grasp|sa|csa> [--threads N] [--time-limit S] [--first-test K]
+ *                        [--family NAME] [--orlib|--m] instance ...
+ */
+
+namespace {
+	std::string directoryName(const std::string& path) {
+		std::size_t end = path.find_last_of("/\\");
+		if (end == std::string::npos) {
+			return ".";
+		}
+		std::size_t begin = path.find_last_of("/\\", end - 1);
+		return path.substr(begin == std::string::npos ? 0 : begin + 1, end - (begin == std::string::npos ? 0 : begin + 1));
+	}
+
+	template <typename Value>
+	std::string format(const char* name, Value value) {
+		std::ostringstream stream;
+		stream << name << '=' << value;
+		return stream.str();
+	}
+
+	bool addGrid(algorithm::RacingTuner& tuner, const std::string& algorithm) {
+		if (algorithm == "grasp") {
+			for (double alpha : { 0.05, 0.1, 0.2, 0.3, 0.5, 0.7 }) {
+				tuner.addConfiguration("GRASP " + format("alpha", alpha) + " iterations=10",
+									   [alpha] { return std::make_shared<algorithm::GRASPAlgorithm>(alpha, 10); });
+			}
+		}
+		else if (algorithm == "sa") {
+			for (double initial_temperature : { 100.0, 1000.0, 10000.0 }) {
+				for (double cooling_rate : { 0.8, 0.9, 0.95 }) {
+					for (int iterations : { 100, 200 }) {
+						tuner.addConfiguration("SA " + format("T0", initial_temperature) + " Tf=0.1 " + format("cooling", cooling_rate) + " " + format("L", iterations),
+											   [=] { return std::make_shared<algorithm::SimulatedAnnealingAlgorithm>(initial_temperature, 0.1, cooling_rate, iterations); });
+					}
+				}
+			}
+		}
+		else if (algorithm == "csa") {
+			for (int population : { 100, 200, 400 }) {
+				for (double awareness : { 0.05, 0.1, 0.2, 0.3 }) {
+					tuner.addConfiguration("CSA " + format("population", population) + " " + format("AP", awareness) + " evaluations=80000",
+										   [=] { return std::make_shared<algorithm::CrowSearchAlgorithm>(population, awareness, 80000); });
+				}
+			}
+		}
+		else {
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv) {
+	const char* usage = "Usage: %s <grasp|sa|csa> [--threads N] [--time-limit S] [--first-test K] [--family NAME] [--orlib|--m] instance ...\n";
+	if (argc < 3) {
+		std::fprintf(stderr, usage, argv[0]);
+		return 1;
+	}
+
+	int number_of_threads = 0;
+	double time_limit = 0.0;
+	int first_test = 5;
+	for (int a = 2; a + 1 < argc; ++a) {
+		if (std::strcmp(argv[a], "--threads") == 0) number_of_threads = std::atoi(argv[++a]);
+		else if (std::strcmp(argv[a], "--time-limit") == 0) time_limit = std::atof(argv[++a]);
+		else if (std::strcmp(argv[a], "--first-test") == 0) first_test = std::atoi(argv[++a]);
+	}
+
+	algorithm::RacingTuner tuner(number_of_threads, time_limit, first_test);
+	if (!addGrid(tuner, argv[1])) {
+		std::fprintf(stderr, usage, argv[0]);
+		return 1;
+	}
+
+	miscellaneous::ORLibParser orlib_parser;
+	miscellaneous::MParser m_parser;
+	try {
+		std::string family;
+		bool m_format = false;
+		for (int a = 2; a < argc; ++a) {
+			if (std::strcmp(argv[a], "--threads") == 0 || std::strcmp(argv[a], "--time-limit") == 0 || std::strcmp(argv[a], "--first-test") == 0) {
+				++a;
+			}
+			else if (std::strcmp(argv[a], "--family") == 0 && a + 1 < argc) {
+				family = argv[++a];
+			}
+			else if (std::strcmp(argv[a], "--orlib") == 0) {
+				m_format = false;
+			}
+			else if (std::strcmp(argv[a], "--m") == 0) {
+				m_format = true;
+			}
+			else {
+				auto problem = std::make_shared<const Problem>(m_format ? m_parser.parse(argv[a]) : orlib_parser.parse(argv[a]));
+				tuner.addInstance(family.empty() ? directoryName(argv[a]) : family, problem);
+			}
+		}
+
+		std::printf("family,configuration,runs,mean_rank,mean_gap,mean_seconds,eliminated_after,best\n");
+		for (const auto& race : tuner.raceAll()) {
+			for (const auto& configuration : race.configurations) {
+				std::printf("%s,%s,%d,%.3f,%.6g,%.4f,%d,%d\n", race.family.c_str(), configuration.name.c_str(), configuration.runs,
+							configuration.mean_rank, configuration.mean_gap, configuration.mean_seconds, configuration.eliminated_after,
+							configuration.name == race.best ? 1 : 0);
+			}
+			std::fflush(stdout);
+		}
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+#include "InstanceGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace miscellaneous {
+
+    namespace {
+        class Stream {
+        public:
+            explicit Stream(std::uint64_t seed) : state(seed) {}
+
+            std::uint64_t next() {
+                std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            }
+
+            /**
+             * @brief Uniform in [0, 1) with 53 random bits.
+             */
+            double uniform() {
+                return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+            }
+
+            double uniform(double low, double high) {
+                return low + (high - low) * uniform();
+            }
+
+            int integer(int low, int high) {
+                return low + static_cast<int>(uniform() * (high - low + 1));
+            }
+
+            /**
+             * @brief Standard normal deviate (Box-Muller).
+             */
+            double normal() {
+                double u = 1.0 - uniform();
+                double v = uniform();
+                return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+            }
+
+        private:
+            std::uint64_t state;
+        };
+
+        double roundTo(double value, double scale) {
+            return std::round(value * scale) / scale;
+        }
+
+        const double SIDE = 1000.0;
+
+        struct Point {
+            double x, y;
+        };
+
+        /**
+         * @brief Adds a customer with its dense costs, or keeps its cheapest entries when generating sparse.
+         */
+        void addCustomer(Problem& problem, std::vector<std::vector<SparseCosts::Entry>>& rows, int nearest_facilities,
+                         int demand, std::vector<double>&& costs) {
+            if (nearest_facilities <= 0) {
+                problem.addCustomer(Customer(demand, std::move(costs)));
+                return;
+            }
+
+            std::vector<SparseCosts::Entry> row;
+            row.reserve(costs.size());
+            for (std::size_t i = 0; i < costs.size(); ++i) {
+                row.emplace_back(static_cast<int>(i), costs[i]);
+            }
+            std::size_t k = std::min(row.size(), static_cast<std::size_t>(nearest_facilities));
+            std::nth_element(row.begin(), row.begin() + (k - 1), row.end(), [](const SparseCosts::Entry& a, const SparseCosts::Entry& b) {
+                return a.second < b.second || (a.second == b.second && a.first < b.first);
+            });
+            row.resize(k);
+            row.shrink_to_fit();
+            rows.push_back(std::move(row));
+            problem.addCustomer(Customer(demand, std::vector<double>()));
+        }
+
+        void write(const Problem& problem, const std::string& path, int costs_per_line, int decimals) {
+            if (problem.isSparse()) {
+                throw std::invalid_argument("Sparse instances cannot be written in a dense format");
+            }
+            std::FILE* file = std::fopen(path.c_str(), "w");
+            if (file == nullptr) {
+                throw std::runtime_error("Unable to open file");
+            }
+
+            std::fprintf(file, " %d %d \n", problem.getNumberOfWarehouses(), problem.getNumberOfCustomers());
+            for (const auto& warehouse : problem.getWarehouses()) {
+                std::fprintf(file, " %d %.*f \n", warehouse.getCapacity(), decimals, warehouse.getFixedCost());
+            }
+            for (const auto& customer : problem.getCustomers()) {
+                std::fprintf(file, " %d \n", customer.getDemand());
+                const auto& costs = customer.getAllocationCosts();
+                for (std::size_t i = 0; i < costs.size(); ++i) {
+                    std::fprintf(file, " %.*f", decimals, costs[i]);
+                    if ((i + 1) % costs_per_line == 0 || i + 1 == costs.size()) {
+                        std::fprintf(file, " \n");
+                    }
+                }
+            }
+
+            if (std::fclose(file) != 0) {
+                throw std::runtime_error("Error writing instance file");
+            }
+        }
+    }
+
+    Problem InstanceGenerator::generate(const GeneratorSettings& settings) {
+        const int n = settings.number_of_customers;
+        const int m = settings.number_of_warehouses;
+        if (n <= 0 || m <= 0) {
+            throw std::invalid_argument("Instance sizes must be positive");
+        }
+
+        Stream stream(settings.seed);
+        Problem problem(n, m);
+        problem.warehouses.reserve(m);
+        problem.customers.reserve(n);
+
+        std::vector<std::vector<SparseCosts::Entry>> rows;
+        auto finish = [&]() {
+            if (settings.nearest_facilities > 0) {
+                problem.setSparseCosts(SparseCosts(m, std::move(rows)));
+            }
+        };
+
+        if (settings.family == InstanceFamily::KcapmRandom) {
+            for (int i = 0; i < m; ++i) {
+                int capacity = stream.integer(1, 15);
+                problem.addWarehouse(Warehouse(capacity, roundTo(stream.uniform(100.0, 600.0), 1000.0)));
+            }
+            for (int j = 0; j < n; ++j) {
+                std::vector<double> costs(m);
+                for (int i = 0; i < m; ++i) {
+                    costs[i] = roundTo(stream.uniform(0.0, 10.0), 1000.0);
+                }
+                addCustomer(problem, rows, settings.nearest_facilities, stream.integer(1, 10), std::move(costs));
+            }
+            finish();
+            return problem;
+        }
+
+        // Fixed costs scale with the typical distance so that neither opening everything nor one facility is trivially optimal
+        std::vector<Point> facilities(m);
+        for (int i = 0; i < m; ++i) {
+            facilities[i] = { stream.uniform(0.0, SIDE), stream.uniform(0.0, SIDE) };
+            double fixed_cost = std::round(stream.uniform(0.5, 1.5) * SIDE * 50.0 * std::sqrt(static_cast<double>(n) / m));
+            problem.addWarehouse(Warehouse(0, fixed_cost));
+        }
+
+        std::vector<Point> centres(std::max(1, settings.number_of_clusters));
+        for (auto& centre : centres) {
+            centre = { stream.uniform(0.0, SIDE), stream.uniform(0.0, SIDE) };
+        }
+
+        for (int j = 0; j < n; ++j) {
+            Point point;
+            if (settings.family == InstanceFamily::Clustered) {
+                const Point& centre = centres[stream.integer(0, static_cast<int>(centres.size()) - 1)];
+                point = { std::min(SIDE, std::max(0.0, centre.x + 0.05 * SIDE * stream.normal())),
+                          std::min(SIDE, std::max(0.0, centre.y + 0.05 * SIDE * stream.normal())) };
+            }
+            else {
+                point = { stream.uniform(0.0, SIDE), stream.uniform(0.0, SIDE) };
+            }
+
+            int demand = stream.integer(1, 100);
+            std::vector<double> costs(m);
+            for (int i = 0; i < m; ++i) {
+                double dx = point.x - facilities[i].x;
+                double dy = point.y - facilities[i].y;
+                double distance = std::sqrt(dx * dx + dy * dy);
+                costs[i] = roundTo(demand * distance, 100000.0);
+            }
+            addCustomer(problem, rows, settings.nearest_facilities, demand, std::move(costs));
+        }
+
+        finish();
+        return problem;
+    }
+
+    void InstanceGenerator::writeORLib(const Problem& problem, const std::string& path) {
+        write(problem, path, 7, 5);
+    }
+
+    void InstanceGenerator::writeM(const Problem& problem, const std::string& path) {
+        write(problem, path, 8, 3);
+    }
+}
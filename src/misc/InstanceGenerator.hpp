@@ -0,0 +1,57 @@
+#pragma once
+#include "../problem/Problem.hpp"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Namespace for the miscellaneous classes
+ */
+namespace miscellaneous {
+
+	/**
+	 * @brief Families of synthetic instances.
+	 *
+	 * Euclidean: customers and facilities uniform in a square, cost = demand * distance.
+	 * Clustered: customers gathered around a few centres, facilities uniform, cost = demand * distance.
+	 * KcapmRandom: like the bundled Kcapm* instances, costs uniform in [0, 10) with three decimals.
+	 */
+	enum class InstanceFamily { Euclidean, Clustered, KcapmRandom };
+
+	struct GeneratorSettings {
+		InstanceFamily family = InstanceFamily::Euclidean;
+		int number_of_customers = 1000;
+		int number_of_warehouses = 1000;
+		std::uint64_t seed = 1;
+		int number_of_clusters = 10;
+		/**
+		 * @brief If positive, only this many cheapest facilities per customer are kept and the
+		 * instance is generated straight into sparse storage (Problem::isSparse).
+		 */
+		int nearest_facilities = 0;
+	};
+
+	/**
+	 * @brief Deterministic generator of large synthetic instances.
+	 *
+	 * The random stream is splitmix64 and every distribution is computed here rather than taken
+	 * from <random>, whose distributions differ between standard libraries, so a seed always
+	 * produces the same instance. Euclidean and clustered costs keep the five decimals of the
+	 * ORLib format and Kcapm costs the three of the M format, so writing an instance in its
+	 * format and parsing it back gives it back exactly.
+	 */
+	class InstanceGenerator {
+	public:
+		static Problem generate(const GeneratorSettings& settings);
+
+		/**
+		 * @brief Writes the instance in the ORLib format read by ORLibParser (seven costs per line).
+		 * Both formats are dense, so sparse instances cannot be written.
+		 */
+		static void writeORLib(const Problem& problem, const std::string& path);
+
+		/**
+		 * @brief Writes the instance in the M format read by MParser (eight costs per line).
+		 */
+		static void writeM(const Problem& problem, const std::string& path);
+	};
+}
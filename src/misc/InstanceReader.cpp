@@ -0,0 +1,185 @@
+#include "InstanceReader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace miscellaneous {
+
+    namespace {
+        bool isSpace(char c) {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        }
+
+        long long countTokens(const char* begin, const char* end) {
+            long long tokens = 0;
+            bool in_token = false;
+            for (const char* p = begin; p < end; ++p) {
+                bool space = isSpace(*p);
+                if (!space && !in_token) {
+                    ++tokens;
+                }
+                in_token = !space;
+            }
+            return tokens;
+        }
+    }
+
+    InstanceReader::InstanceReader(const std::string& path, int number_of_threads)
+        : number_of_threads(number_of_threads) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open file");
+        }
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        contents = buffer.str();
+        cursor = contents.c_str();
+
+        if (this->number_of_threads <= 0) {
+            int by_size = 1 + static_cast<int>(contents.size() >> 20);
+            int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            this->number_of_threads = std::min(by_size, hardware);
+        }
+    }
+
+    double InstanceReader::next(const char* error_message) {
+        char* after;
+        double value = std::strtod(cursor, &after);
+        if (after == cursor) {
+            throw std::runtime_error(error_message);
+        }
+        cursor = after;
+        return value;
+    }
+
+    Problem InstanceReader::readProblem() {
+        Problem problem;
+
+        problem.num_warehouses = static_cast<int>(next("Error reading number of warehouses and customers"));
+        problem.num_customers = static_cast<int>(next("Error reading number of warehouses and customers"));
+        if (problem.num_warehouses < 0 || problem.num_customers < 0) {
+            throw std::runtime_error("Error reading number of warehouses and customers");
+        }
+
+        problem.warehouses.reserve(problem.num_warehouses);
+        for (int i = 0; i < problem.num_warehouses; ++i) {
+            int capacity = static_cast<int>(next("Error reading warehouse data"));
+            double fixed_cost = next("Error reading warehouse data");
+            problem.addWarehouse(Warehouse(capacity, fixed_cost));
+        }
+
+        readCustomers(problem);
+        return problem;
+    }
+
+    /**
+     * Every customer is a demand followed by num_warehouses costs, so the k-th number of the
+     * section belongs to customer k / (num_warehouses + 1). A first pass counts the numbers in
+     * every chunk; their prefix sums give each chunk the index of its first number, so the
+     * second pass can place every number without looking at the other chunks.
+     */
+    void InstanceReader::readCustomers(Problem& problem) {
+        const int n = problem.num_customers;
+        const int m = problem.num_warehouses;
+        const long long record_size = static_cast<long long>(m) + 1;
+        const long long needed = record_size * n;
+
+        const char* begin = cursor;
+        const char* end = contents.c_str() + contents.size();
+
+        int chunks = std::max(1, number_of_threads);
+        std::vector<const char*> boundaries(chunks + 1, end);
+        boundaries[0] = begin;
+        for (int t = 1; t < chunks; ++t) {
+            const char* p = std::max(boundaries[t - 1], begin + (end - begin) * t / chunks);
+            while (p < end && !isSpace(*p)) {
+                ++p;
+            }
+            boundaries[t] = p;
+        }
+
+        std::vector<long long> first_token(chunks + 1, 0);
+        std::vector<std::vector<double>> costs(n);
+        std::vector<int> demands(n, 0);
+        std::atomic<bool> failed(false);
+
+        auto runParallel = [&](auto&& work) {
+            std::vector<std::thread> threads;
+            for (int t = 1; t < chunks; ++t) {
+                threads.emplace_back(work, t);
+            }
+            work(0);
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        };
+
+        // Pass 1: count the numbers of every chunk and allocate a block of customers' cost vectors
+        runParallel([&](int t) {
+            first_token[t + 1] = countTokens(boundaries[t], boundaries[t + 1]);
+            for (int j = static_cast<int>(static_cast<long long>(n) * t / chunks);
+                 j < static_cast<int>(static_cast<long long>(n) * (t + 1) / chunks); ++j) {
+                costs[j].resize(m);
+            }
+        });
+
+        for (int t = 0; t < chunks; ++t) {
+            first_token[t + 1] += first_token[t];
+        }
+        if (first_token[chunks] < needed) {
+            throw std::runtime_error("Error reading customer data");
+        }
+
+        // Pass 2: parse every chunk straight into its customers' cost vectors
+        runParallel([&](int t) {
+            long long k = first_token[t];
+            const char* p = boundaries[t];
+            const char* chunk_end = boundaries[t + 1];
+
+            while (k < needed) {
+                while (p < chunk_end && isSpace(*p)) {
+                    ++p;
+                }
+                if (p >= chunk_end) {
+                    break;
+                }
+
+                char* after;
+                double value = std::strtod(p, &after);
+                if (after == p) {
+                    failed.store(true);
+                    return;
+                }
+                p = after;
+
+                int j = static_cast<int>(k / record_size);
+                int field = static_cast<int>(k % record_size);
+                if (field == 0) {
+                    demands[j] = static_cast<int>(value);
+                }
+                else {
+                    costs[j][field - 1] = value;
+                }
+                ++k;
+            }
+        });
+
+        if (failed.load()) {
+            throw std::runtime_error("Error reading allocation costs");
+        }
+
+        problem.customers.reserve(n);
+        for (int j = 0; j < n; ++j) {
+            problem.addCustomer(Customer(demands[j], std::move(costs[j])));
+        }
+        cursor = end;
+    }
+}
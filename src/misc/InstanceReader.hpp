@@ -0,0 +1,44 @@
+#pragma once
+#include "../problem/Problem.hpp"
+#include <string>
+
+/**
+ * @brief Namespace for the miscellaneous classes
+ */
+namespace miscellaneous {
+
+	/**
+	 * @brief Shared reading code of the instance parsers.
+	 *
+	 * The file is read in one go. The header and the warehouses are parsed serially; the customer
+	 * section, which holds almost all of the numbers, is split into chunks at whitespace that are
+	 * first token-counted and then parsed in parallel, each number written straight into the
+	 * preallocated cost vector of its customer. Line layout does not matter, so the ORLib and the
+	 * M formats share the same reader.
+	 */
+	class InstanceReader {
+	public:
+		/**
+		 * @param path Instance file.
+		 * @param number_of_threads Threads parsing the customer section; 0 picks one per MiB of file, up to the hardware concurrency.
+		 */
+		explicit InstanceReader(const std::string& path, int number_of_threads = 0);
+
+		/**
+		 * @brief Parses the next number. Throws std::runtime_error with the given message if there is none.
+		 */
+		double next(const char* error_message);
+
+		/**
+		 * @brief Parses the header "warehouses customers", the warehouses and the customers.
+		 */
+		Problem readProblem();
+
+	private:
+		void readCustomers(Problem& problem);
+
+		std::string contents;
+		const char* cursor;
+		int number_of_threads;
+	};
+}
@@ -0,0 +1,194 @@
+#include "Logger.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace miscellaneous {
+
+    namespace {
+        const char* levelName(LogLevel level) {
+            switch (level) {
+            case LogLevel::Trace: return "TRACE";
+            case LogLevel::Debug: return "DEBUG";
+            case LogLevel::Info: return "INFO";
+            case LogLevel::Warning: return "WARN";
+            case LogLevel::Error: return "ERROR";
+            default: return "OFF";
+            }
+        }
+
+        LogLevel levelFromEnvironment() {
+            const char* value = std::getenv("UFLP_LOG_LEVEL");
+            if (value == nullptr) {
+                return LogLevel::Info;
+            }
+
+            std::string name(value);
+            if (name == "trace") return LogLevel::Trace;
+            if (name == "debug") return LogLevel::Debug;
+            if (name == "info") return LogLevel::Info;
+            if (name == "warning") return LogLevel::Warning;
+            if (name == "error") return LogLevel::Error;
+            if (name == "off") return LogLevel::Off;
+            return LogLevel::Info;
+        }
+    }
+
+    Logger& Logger::instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    Logger::Logger()
+        : current_level(static_cast<int>(levelFromEnvironment())),
+          sink(&std::clog),
+          start_time(std::chrono::steady_clock::now()) {
+        for (std::size_t i = 0; i < CAPACITY; ++i) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    Logger::~Logger() {
+        if (worker_started.load()) {
+            stopping.store(true);
+            {
+                std::lock_guard<std::mutex> lock(worker_mutex);
+                worker_signal.notify_one();
+            }
+            worker.join();
+        }
+    }
+
+    void Logger::setLevel(LogLevel level) {
+        current_level.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    LogLevel Logger::getLevel() const {
+        return static_cast<LogLevel>(current_level.load(std::memory_order_relaxed));
+    }
+
+    void Logger::setSink(std::ostream& stream) {
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        sink = &stream;
+    }
+
+    void Logger::ensureWorker() {
+        if (worker_started.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(worker_mutex);
+        if (!worker_started.load(std::memory_order_relaxed)) {
+            worker = std::thread(&Logger::run, this);
+            worker_started.store(true, std::memory_order_release);
+        }
+    }
+
+    /**
+     * Bounded multi-producer queue (Vyukov): each slot carries a sequence number telling
+     * producers whether it is free and the consumer whether it has been published.
+     */
+    void Logger::log(LogLevel level, const char* format, ...) {
+        ensureWorker();
+
+        std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+        Record* record = nullptr;
+
+        while (true) {
+            record = &buffer[position & (CAPACITY - 1)];
+            std::size_t sequence = record->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0) {
+                if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else {
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->level = level;
+        record->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        va_list arguments;
+        va_start(arguments, format);
+        std::vsnprintf(record->text, MESSAGE_SIZE, format, arguments);
+        va_end(arguments);
+
+        record->sequence.store(position + 1, std::memory_order_release);
+
+        if (worker_sleeping.load(std::memory_order_acquire)) {
+            worker_signal.notify_one();
+        }
+    }
+
+    bool Logger::drainOne(std::ostream& out) {
+        std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+        Record& record = buffer[position & (CAPACITY - 1)];
+
+        if (record.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+
+        char prefix[32];
+        std::snprintf(prefix, sizeof(prefix), "[%9.3fs] [%s] ", record.seconds, levelName(record.level));
+        out << prefix << record.text << '\n';
+
+        record.sequence.store(position + CAPACITY, std::memory_order_release);
+        dequeue_position.store(position + 1, std::memory_order_relaxed);
+        written.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    void Logger::run() {
+        while (true) {
+            bool any = false;
+            {
+                std::lock_guard<std::mutex> lock(sink_mutex);
+                while (drainOne(*sink)) {
+                    any = true;
+                }
+                if (any) {
+                    sink->flush();
+                }
+            }
+
+            if (stopping.load()) {
+                std::lock_guard<std::mutex> lock(sink_mutex);
+                while (drainOne(*sink)) {}
+                sink->flush();
+                return;
+            }
+
+            if (!any) {
+                std::unique_lock<std::mutex> lock(worker_mutex);
+                worker_sleeping.store(true, std::memory_order_release);
+                worker_signal.wait_for(lock, std::chrono::milliseconds(50));
+                worker_sleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void Logger::flush() {
+        if (!worker_started.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        std::size_t target = enqueue_position.load(std::memory_order_acquire);
+        worker_signal.notify_one();
+        while (written.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+        }
+
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        sink->flush();
+    }
+}
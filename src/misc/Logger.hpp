@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+/**
+ * @brief Lowest level compiled into the binary. Log statements below it expand to nothing.
+ * 0 = Trace, 1 = Debug, 2 = Info, 3 = Warning, 4 = Error.
+ */
+#ifndef UFLP_LOG_COMPILE_LEVEL
+#define UFLP_LOG_COMPILE_LEVEL 0
+#endif
+
+/**
+ * @brief Namespace for the miscellaneous classes
+ */
+namespace miscellaneous {
+
+	/**
+	 * @brief Severity of a log record. Off disables every record.
+	 */
+	enum class LogLevel : int {
+		Trace = 0,
+		Debug = 1,
+		Info = 2,
+		Warning = 3,
+		Error = 4,
+		Off = 5
+	};
+
+	/**
+	 * @brief Asynchronous logger used by the solvers.
+	 *
+	 * Records are formatted by the calling thread into a fixed-size slot of a bounded
+	 * lock-free ring buffer and written to the sink by a background thread, so a solver
+	 * never blocks on console I/O. When the buffer is full the record is dropped and counted
+	 * instead of stalling the caller. The enabled check is a single relaxed atomic load,
+	 * and the UFLP_LOG_* macros skip argument evaluation entirely when the level is off.
+	 *
+	 * The initial level is Info, or the value of the UFLP_LOG_LEVEL environment variable
+	 * (trace, debug, info, warning, error, off).
+	 */
+	class Logger {
+	public:
+		static constexpr std::size_t CAPACITY = 1024;
+		static constexpr std::size_t MESSAGE_SIZE = 240;
+
+		static Logger& instance();
+
+		Logger(const Logger&) = delete;
+		Logger& operator=(const Logger&) = delete;
+
+		bool isEnabled(LogLevel level) const {
+			return static_cast<int>(level) >= current_level.load(std::memory_order_relaxed);
+		}
+
+		void setLevel(LogLevel level);
+		LogLevel getLevel() const;
+
+		/**
+		 * @brief Redirects the output. The stream must outlive the logger or the next setSink call.
+		 */
+		void setSink(std::ostream& stream);
+
+		/**
+		 * @brief Enqueues a printf-style record. Never blocks; drops the record if the buffer is full.
+		 */
+		void log(LogLevel level, const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+			__attribute__((format(printf, 3, 4)))
+#endif
+			;
+
+		/**
+		 * @brief Blocks until every record enqueued so far has been written to the sink.
+		 */
+		void flush();
+
+		std::uint64_t getDroppedCount() const {
+			return dropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		struct Record {
+			std::atomic<std::size_t> sequence;
+			LogLevel level;
+			double seconds;
+			char text[MESSAGE_SIZE];
+		};
+
+		Logger();
+		~Logger();
+
+		void ensureWorker();
+		bool drainOne(std::ostream& out);
+		void run();
+
+		Record buffer[CAPACITY];
+		alignas(64) std::atomic<std::size_t> enqueue_position{ 0 };
+		alignas(64) std::atomic<std::size_t> dequeue_position{ 0 };
+		alignas(64) std::atomic<std::size_t> written{ 0 };
+		std::atomic<std::uint64_t> dropped{ 0 };
+		std::atomic<int> current_level;
+
+		std::atomic<bool> worker_started{ false };
+		std::atomic<bool> worker_sleeping{ false };
+		std::atomic<bool> stopping{ false };
+		std::mutex worker_mutex;
+		std::condition_variable worker_signal;
+		std::thread worker;
+
+		std::mutex sink_mutex;
+		std::ostream* sink;
+		std::chrono::steady_clock::time_point start_time;
+	};
+}
+
+#define UFLP_LOG_AT(level_value, level, ...)                                                   \
+	do {                                                                                       \
+		if ((level_value) >= UFLP_LOG_COMPILE_LEVEL &&                                         \
+			::miscellaneous::Logger::instance().isEnabled(::miscellaneous::LogLevel::level)) { \
+			::miscellaneous::Logger::instance().log(::miscellaneous::LogLevel::level, __VA_ARGS__); \
+		}                                                                                      \
+	} while (0)
+
+#define UFLP_LOG_TRACE(...) UFLP_LOG_AT(0, Trace, __VA_ARGS__)
+#define UFLP_LOG_DEBUG(...) UFLP_LOG_AT(1, Debug, __VA_ARGS__)
+#define UFLP_LOG_INFO(...) UFLP_LOG_AT(2, Info, __VA_ARGS__)
+#define UFLP_LOG_WARNING(...) UFLP_LOG_AT(3, Warning, __VA_ARGS__)
+#define UFLP_LOG_ERROR(...) UFLP_LOG_AT(4, Error, __VA_ARGS__)
@@ -0,0 +1,424 @@
+#pragma once
+#include "Warehouse.hpp"
+#include "Customer.hpp"
+#include "FacilityOrder.hpp"
+#include "SparseCosts.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Numeric type used for the allocation costs scanned during the search.
+ * Float and Fixed32 halve the bytes streamed per evaluation and double the SIMD lanes;
+ * Fixed64 keeps the width but is exact for costs with up to six decimals.
+ */
+enum class CostPrecision { Double, Float, Fixed32, Fixed64 };
+
+/**
+ * @brief Flat customer-major copy of the allocation costs used by the search.
+ * Costs are reported back in the problem's units, so only rounding differs between precisions.
+ */
+class CostMatrix {
+public:
+    virtual ~CostMatrix() {}
+
+    virtual CostPrecision getPrecision() const = 0;
+
+    /**
+     * @brief Cost of an open set: fixed costs plus, for every customer, its cheapest open facility.
+     * An empty open set costs std::numeric_limits<double>::max().
+     */
+    virtual double evaluate(const std::vector<bool>& open) const = 0;
+
+    /**
+     * @brief Same cost, found by walking each customer's sorted facilities up to the first open one.
+     * Faster than the scan when many facilities are open.
+     */
+    virtual double evaluate(const std::vector<bool>& open, const FacilityOrder& order) const = 0;
+
+    /**
+     * @brief Costs of many open sets at once: costs[b] is evaluate(*open_sets[b]).
+     * Customers are taken in tiles whose rows fit in L2, and every open set is evaluated on a
+     * tile before the next one is read, so each row comes from memory once per batch instead of
+     * once per open set. Every open set is expanded to an m-entry mask for the sweep, so keep
+     * batches small (a few dozen sets) and send longer lists in chunks.
+     */
+    virtual void evaluateBatch(const std::vector<const std::vector<bool>*>& open_sets, std::vector<double>& costs) const = 0;
+
+    /**
+     * @brief Batch version of the sorted walk: costs[b] is evaluate(*open_sets[b], order).
+     * The same k x m masks are built, so the batch must stay small here too.
+     */
+    virtual void evaluateBatch(const std::vector<const std::vector<bool>*>& open_sets, const FacilityOrder& order,
+                               std::vector<double>& costs) const = 0;
+
+protected:
+    /**
+     * @brief Customers per tile when each one reads the given number of bytes: half of a 256 KiB L2,
+     * the other half being left to the open sets of the batch.
+     */
+    static int tileSize(std::size_t bytes_per_customer) {
+        return static_cast<int>(std::max<std::size_t>(1, (128 * 1024) / std::max<std::size_t>(1, bytes_per_customer)));
+    }
+};
+
+/**
+ * @brief Cost matrix stored as T. Integer types hold round(cost * scale).
+ */
+template <typename T>
+class TypedCostMatrix : public CostMatrix {
+public:
+    using Accumulator = typename std::conditional<std::is_integral<T>::value, std::int64_t, double>::type;
+
+    TypedCostMatrix(const std::vector<Customer>& customers, const std::vector<Warehouse>& warehouses, double scale)
+        : number_of_customers(static_cast<int>(customers.size())),
+          number_of_warehouses(static_cast<int>(warehouses.size())),
+          scale(std::is_integral<T>::value ? scale : 1.0),
+          costs(static_cast<std::size_t>(customers.size()) * warehouses.size()),
+          fixed_costs(warehouses.size()) {
+        for (int j = 0; j < number_of_customers; ++j) {
+            const auto& row = customers[j].getAllocationCosts();
+            for (int i = 0; i < number_of_warehouses; ++i) {
+                costs[static_cast<std::size_t>(j) * number_of_warehouses + i] = fromDouble(row[i]);
+            }
+        }
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            fixed_costs[i] = std::is_integral<T>::value ? static_cast<Accumulator>(std::llround(warehouses[i].getFixedCost() * this->scale))
+                                                         : static_cast<Accumulator>(warehouses[i].getFixedCost());
+        }
+    }
+
+    CostPrecision getPrecision() const override {
+        if (std::is_same<T, float>::value) return CostPrecision::Float;
+        if (std::is_same<T, std::int32_t>::value) return CostPrecision::Fixed32;
+        if (std::is_same<T, std::int64_t>::value) return CostPrecision::Fixed64;
+        return CostPrecision::Double;
+    }
+
+    /**
+     * @brief Scans every row under the open set's penalty vector; see rowMinimum.
+     */
+    double evaluate(const std::vector<bool>& open) const override {
+        std::vector<T> penalty(number_of_warehouses);
+        Accumulator total = 0;
+        if (!setPenalty(open, penalty.data(), total)) {
+            return std::numeric_limits<double>::max();
+        }
+
+        for (int j = 0; j < number_of_customers; ++j) {
+            total += rowMinimum(getRow(j), penalty.data());
+        }
+        return static_cast<double>(total) / scale;
+    }
+
+    double evaluate(const std::vector<bool>& open, const FacilityOrder& order) const override {
+        std::vector<char> is_open(number_of_warehouses);
+        Accumulator total = 0;
+        if (!setOpen(open, is_open.data(), total)) {
+            return std::numeric_limits<double>::max();
+        }
+
+        walkSorted(is_open.data(), order, 0, number_of_customers, total);
+        return static_cast<double>(total) / scale;
+    }
+
+    void evaluateBatch(const std::vector<const std::vector<bool>*>& open_sets, std::vector<double>& costs) const override {
+        const std::size_t k = open_sets.size();
+        std::vector<T> penalties(k * number_of_warehouses);
+        std::vector<Accumulator> totals(k, 0);
+        std::vector<char> any_open(k);
+        for (std::size_t b = 0; b < k; ++b) {
+            any_open[b] = setPenalty(*open_sets[b], &penalties[b * number_of_warehouses], totals[b]);
+        }
+
+        const int tile = tileSize(number_of_warehouses * sizeof(T));
+        for (int first = 0; first < number_of_customers; first += tile) {
+            const int last = std::min(number_of_customers, first + tile);
+            for (std::size_t b = 0; b < k; ++b) {
+                if (!any_open[b]) {
+                    continue;
+                }
+                const T* penalty = &penalties[b * number_of_warehouses];
+                Accumulator total = 0;
+                for (int j = first; j < last; ++j) {
+                    total += rowMinimum(getRow(j), penalty);
+                }
+                totals[b] += total;
+            }
+        }
+
+        costs.resize(k);
+        for (std::size_t b = 0; b < k; ++b) {
+            costs[b] = any_open[b] ? static_cast<double>(totals[b]) / scale : std::numeric_limits<double>::max();
+        }
+    }
+
+    void evaluateBatch(const std::vector<const std::vector<bool>*>& open_sets, const FacilityOrder& order,
+                       std::vector<double>& costs) const override {
+        const std::size_t k = open_sets.size();
+        std::vector<char> is_open(k * number_of_warehouses);
+        std::vector<Accumulator> totals(k, 0);
+        std::vector<char> any_open(k);
+        for (std::size_t b = 0; b < k; ++b) {
+            any_open[b] = setOpen(*open_sets[b], &is_open[b * number_of_warehouses], totals[b]);
+        }
+
+        // A walk reads the front of the sorted row and a few scattered costs; tile by both rows
+        const std::size_t index_bytes = order.isNarrow() ? sizeof(std::uint16_t) : sizeof(std::int32_t);
+        const int tile = tileSize(number_of_warehouses * (sizeof(T) + index_bytes));
+        for (int first = 0; first < number_of_customers; first += tile) {
+            const int last = std::min(number_of_customers, first + tile);
+            for (std::size_t b = 0; b < k; ++b) {
+                if (any_open[b]) {
+                    walkSorted(&is_open[b * number_of_warehouses], order, first, last, totals[b]);
+                }
+            }
+        }
+
+        costs.resize(k);
+        for (std::size_t b = 0; b < k; ++b) {
+            costs[b] = any_open[b] ? static_cast<double>(totals[b]) / scale : std::numeric_limits<double>::max();
+        }
+    }
+
+    const T* getRow(int j) const { return &costs[static_cast<std::size_t>(j) * number_of_warehouses]; }
+    double getScale() const { return scale; }
+
+    T fromDouble(double cost) const {
+        return std::is_integral<T>::value ? static_cast<T>(std::llround(cost * scale)) : static_cast<T>(cost);
+    }
+
+private:
+    /**
+     * @brief Fills the penalty vector of an open set (0 open, closedPenalty() closed) and adds its fixed costs to total.
+     * @return Whether any facility is open.
+     */
+    bool setPenalty(const std::vector<bool>& open, T* penalty, Accumulator& total) const {
+        bool any_open = false;
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            penalty[i] = open[i] ? T(0) : closedPenalty();
+            if (open[i]) {
+                total += fixed_costs[i];
+                any_open = true;
+            }
+        }
+        return any_open;
+    }
+
+    /**
+     * @brief Same as setPenalty with a byte per facility, for the sorted walks.
+     */
+    bool setOpen(const std::vector<bool>& open, char* is_open, Accumulator& total) const {
+        bool any_open = false;
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            is_open[i] = open[i] ? 1 : 0;
+            if (open[i]) {
+                total += fixed_costs[i];
+                any_open = true;
+            }
+        }
+        return any_open;
+    }
+
+    /**
+     * @brief Cheapest cost of a row under a penalty vector. Closed facilities get a penalty instead of
+     * a branch, and the minimum uses four independent accumulators, so the loop vectorises for every T.
+     */
+    Accumulator rowMinimum(const T* row, const T* penalty) const {
+        T best0 = closedPenalty(), best1 = closedPenalty(), best2 = closedPenalty(), best3 = closedPenalty();
+        int i = 0;
+        for (; i + 4 <= number_of_warehouses; i += 4) {
+            best0 = std::min(best0, static_cast<T>(row[i] + penalty[i]));
+            best1 = std::min(best1, static_cast<T>(row[i + 1] + penalty[i + 1]));
+            best2 = std::min(best2, static_cast<T>(row[i + 2] + penalty[i + 2]));
+            best3 = std::min(best3, static_cast<T>(row[i + 3] + penalty[i + 3]));
+        }
+        for (; i < number_of_warehouses; ++i) {
+            best0 = std::min(best0, static_cast<T>(row[i] + penalty[i]));
+        }
+        return static_cast<Accumulator>(std::min(std::min(best0, best1), std::min(best2, best3)));
+    }
+
+    /**
+     * @brief Adds the nearest open cost of customers [first, last) to total.
+     */
+    void walkSorted(const char* is_open, const FacilityOrder& order, int first, int last, Accumulator& total) const {
+        if (order.isNarrow()) {
+            walkSorted(is_open, order, &FacilityOrder::getNarrowRow, first, last, total);
+        }
+        else {
+            walkSorted(is_open, order, &FacilityOrder::getWideRow, first, last, total);
+        }
+    }
+
+    template <typename Index>
+    void walkSorted(const char* is_open, const FacilityOrder& order,
+                    const Index* (FacilityOrder::*getOrderRow)(int) const, int first, int last, Accumulator& total) const {
+        for (int j = first; j < last; ++j) {
+            const Index* facilities = (order.*getOrderRow)(j);
+            int rank = 0;
+            while (!is_open[facilities[rank]]) {
+                ++rank;
+            }
+            total += static_cast<Accumulator>(getRow(j)[facilities[rank]]);
+        }
+    }
+
+    /**
+     * @brief Added to the costs of closed facilities. Half the range of T, so cost + penalty cannot overflow.
+     */
+    static T closedPenalty() {
+        return std::is_integral<T>::value ? std::numeric_limits<T>::max() / 2 : std::numeric_limits<T>::infinity();
+    }
+
+    int number_of_customers;
+    int number_of_warehouses;
+    double scale;
+    std::vector<T> costs;
+    std::vector<Accumulator> fixed_costs;
+};
+
+/**
+ * @brief Search costs of a sparse problem. Rows are already sorted, so both evaluations walk
+ * each customer's row to its first open facility; a customer none of whose facilities is
+ * open makes the open set infeasible, which costs std::numeric_limits<double>::max().
+ */
+class SparseCostMatrix : public CostMatrix {
+public:
+    SparseCostMatrix(std::shared_ptr<const SparseCosts> costs, const std::vector<Warehouse>& warehouses)
+        : costs(std::move(costs)), fixed_costs(warehouses.size()) {
+        for (std::size_t i = 0; i < warehouses.size(); ++i) {
+            fixed_costs[i] = warehouses[i].getFixedCost();
+        }
+    }
+
+    CostPrecision getPrecision() const override {
+        return CostPrecision::Double;
+    }
+
+    double evaluate(const std::vector<bool>& open) const override {
+        double total = 0.0;
+        for (std::size_t i = 0; i < fixed_costs.size(); ++i) {
+            if (open[i]) {
+                total += fixed_costs[i];
+            }
+        }
+
+        for (int j = 0; j < costs->getNumberOfCustomers(); ++j) {
+            std::size_t e = costs->rowBegin(j);
+            std::size_t end = costs->rowEnd(j);
+            while (e < end && !open[costs->getFacility(e)]) {
+                ++e;
+            }
+            if (e == end) {
+                return std::numeric_limits<double>::max();
+            }
+            total += costs->getCost(e);
+        }
+        return total;
+    }
+
+    double evaluate(const std::vector<bool>& open, const FacilityOrder&) const override {
+        return evaluate(open);
+    }
+
+    void evaluateBatch(const std::vector<const std::vector<bool>*>& open_sets, std::vector<double>& totals) const override {
+        const std::size_t k = open_sets.size();
+        totals.assign(k, 0.0);
+        std::vector<char> served(k, 1);
+        for (std::size_t b = 0; b < k; ++b) {
+            for (std::size_t i = 0; i < fixed_costs.size(); ++i) {
+                if ((*open_sets[b])[i]) {
+                    totals[b] += fixed_costs[i];
+                }
+            }
+        }
+
+        const int n = costs->getNumberOfCustomers();
+        const int tile = tileSize(n > 0 ? costs->getNonZeroCount() / n * (sizeof(double) + sizeof(int)) : 0);
+        for (int first = 0; first < n; first += tile) {
+            const int last = std::min(n, first + tile);
+            for (std::size_t b = 0; b < k; ++b) {
+                const std::vector<bool>& open = *open_sets[b];
+                for (int j = first; j < last && served[b]; ++j) {
+                    std::size_t e = costs->rowBegin(j);
+                    std::size_t end = costs->rowEnd(j);
+                    while (e < end && !open[costs->getFacility(e)]) {
+                        ++e;
+                    }
+                    if (e == end) {
+                        served[b] = 0;
+                    }
+                    else {
+                        totals[b] += costs->getCost(e);
+                    }
+                }
+            }
+        }
+
+        for (std::size_t b = 0; b < k; ++b) {
+            if (!served[b]) {
+                totals[b] = std::numeric_limits<double>::max();
+            }
+        }
+    }
+
+    void evaluateBatch(const std::vector<const std::vector<bool>*>& open_sets, const FacilityOrder&, std::vector<double>& totals) const override {
+        evaluateBatch(open_sets, totals);
+    }
+
+private:
+    std::shared_ptr<const SparseCosts> costs;
+    std::vector<double> fixed_costs;
+};
+
+/**
+ * @brief Largest power of ten, up to 10^6, by which every allocation cost can be scaled and still fit in a quarter of the range of T.
+ */
+template <typename T>
+double fixedPointScale(const std::vector<Customer>& customers) {
+    double largest = 0.0;
+    for (const auto& customer : customers) {
+        for (double cost : customer.getAllocationCosts()) {
+            largest = std::max(largest, std::abs(cost));
+        }
+    }
+
+    double limit = static_cast<double>(std::numeric_limits<T>::max() / 4);
+    double scale = 1e6;
+    while (scale > 1.0 && largest * scale > limit) {
+        scale /= 10.0;
+    }
+    if (largest * scale > limit) {
+        throw std::overflow_error("Allocation costs do not fit the fixed-point cost type");
+    }
+    return scale;
+}
+
+/**
+ * @brief Builds the search cost matrix for the given precision.
+ *
+ * @param scale Fixed-point scale; 0 picks the largest power of ten that fits. An explicit scale is not range-checked.
+ */
+inline std::shared_ptr<const CostMatrix> makeCostMatrix(const std::vector<Customer>& customers, const std::vector<Warehouse>& warehouses,
+                                                        CostPrecision precision, double scale = 0.0) {
+    switch (precision) {
+    case CostPrecision::Float:
+        return std::make_shared<TypedCostMatrix<float>>(customers, warehouses, 1.0);
+    case CostPrecision::Fixed32:
+        return std::make_shared<TypedCostMatrix<std::int32_t>>(customers, warehouses,
+                                                              scale > 0.0 ? scale : fixedPointScale<std::int32_t>(customers));
+    case CostPrecision::Fixed64:
+        return std::make_shared<TypedCostMatrix<std::int64_t>>(customers, warehouses,
+                                                              scale > 0.0 ? scale : fixedPointScale<std::int64_t>(customers));
+    default:
+        return std::make_shared<TypedCostMatrix<double>>(customers, warehouses, 1.0);
+    }
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <utility>
 #include <vector>
 
 /**
@@ -11,6 +12,7 @@ private:
 
 public:
     Customer(int dem, const std::vector<double>& costs) : demand(dem), allocation_costs(costs) {}
+    Customer(int dem, std::vector<double>&& costs) : demand(dem), allocation_costs(std::move(costs)) {}
 
     int getDemand() const {
         return demand;
@@ -0,0 +1,94 @@
+#pragma once
+#include "Customer.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief For every customer, its facilities sorted by increasing allocation cost.
+ *
+ * Walking a customer's row until the first open facility finds its nearest open facility
+ * in about m / open_count steps instead of m, which wins when many facilities are open.
+ * Indices are stored as 16-bit integers when the instance has at most 65536 facilities and
+ * as 32-bit integers otherwise. Ties are broken by facility index, so the walk picks the
+ * same facility as a left-to-right scan.
+ */
+class FacilityOrder {
+public:
+    /**
+     * @param number_of_threads Threads sorting customer blocks; 0 uses the hardware concurrency.
+     */
+    FacilityOrder(const std::vector<Customer>& customers, int number_of_warehouses, int number_of_threads = 0)
+        : number_of_customers(static_cast<int>(customers.size())),
+          number_of_warehouses(number_of_warehouses),
+          narrow(number_of_warehouses <= 65536) {
+        std::size_t size = static_cast<std::size_t>(number_of_customers) * number_of_warehouses;
+        if (narrow) {
+            narrow_order.resize(size);
+        }
+        else {
+            wide_order.resize(size);
+        }
+
+        int threads_to_use = number_of_threads > 0 ? number_of_threads : static_cast<int>(std::thread::hardware_concurrency());
+        threads_to_use = std::max(1, std::min(threads_to_use, number_of_customers));
+
+        auto sortBlock = [&](int first, int last) {
+            std::vector<int> order(number_of_warehouses);
+            for (int j = first; j < last; ++j) {
+                const auto& costs = customers[j].getAllocationCosts();
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return costs[a] < costs[b]; });
+
+                std::size_t offset = static_cast<std::size_t>(j) * number_of_warehouses;
+                for (int r = 0; r < number_of_warehouses; ++r) {
+                    if (narrow) {
+                        narrow_order[offset + r] = static_cast<std::uint16_t>(order[r]);
+                    }
+                    else {
+                        wide_order[offset + r] = order[r];
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        int block = (number_of_customers + threads_to_use - 1) / std::max(1, threads_to_use);
+        for (int t = 1; t < threads_to_use; ++t) {
+            int first = t * block;
+            int last = std::min(number_of_customers, first + block);
+            if (first < last) {
+                threads.emplace_back(sortBlock, first, last);
+            }
+        }
+        sortBlock(0, std::min(number_of_customers, block));
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    int getNumberOfCustomers() const { return number_of_customers; }
+    int getNumberOfWarehouses() const { return number_of_warehouses; }
+    bool isNarrow() const { return narrow; }
+
+    const std::uint16_t* getNarrowRow(int j) const { return &narrow_order[static_cast<std::size_t>(j) * number_of_warehouses]; }
+    const std::int32_t* getWideRow(int j) const { return &wide_order[static_cast<std::size_t>(j) * number_of_warehouses]; }
+
+    /**
+     * @brief Facility of the given rank (0 = cheapest) for customer j.
+     */
+    int at(int j, int rank) const {
+        std::size_t offset = static_cast<std::size_t>(j) * number_of_warehouses + rank;
+        return narrow ? narrow_order[offset] : wide_order[offset];
+    }
+
+private:
+    int number_of_customers;
+    int number_of_warehouses;
+    bool narrow;
+    std::vector<std::uint16_t> narrow_order;
+    std::vector<std::int32_t> wide_order;
+};
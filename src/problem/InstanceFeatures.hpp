@@ -0,0 +1,84 @@
+#pragma once
+#include "Problem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Cheap summary statistics of a Problem, used to pick an algorithm and its parameters.
+ *
+ * Extraction is one pass over the stored allocation costs: O(n * m) for a dense problem and
+ * O(nonzeros) for a sparse one.
+ */
+struct InstanceFeatures {
+    int customers = 0;
+    int warehouses = 0;
+    double density = 0.0;             // Share of customer-facility pairs with a finite cost
+    double cost_spread = 0.0;         // Coefficient of variation of the finite allocation costs
+    double fixed_to_allocation = 0.0; // Total fixed cost over the allocation cost of serving every customer at the mean cost
+    double fixed_spread = 0.0;        // Coefficient of variation of the fixed costs
+
+    static InstanceFeatures extract(const Problem& problem) {
+        InstanceFeatures features;
+        features.customers = problem.getNumberOfCustomers();
+        features.warehouses = problem.getNumberOfWarehouses();
+
+        double count = 0.0, sum = 0.0, sum_of_squares = 0.0;
+        auto add = [&](double cost) {
+            if (std::isfinite(cost)) {
+                count += 1.0;
+                sum += cost;
+                sum_of_squares += cost * cost;
+            }
+        };
+        if (problem.isSparse()) {
+            std::shared_ptr<const SparseCosts> sparse = problem.getSparseCosts();
+            for (int j = 0; j < features.customers; ++j) {
+                for (std::size_t e = sparse->rowBegin(j); e < sparse->rowEnd(j); ++e) {
+                    add(sparse->getCost(e));
+                }
+            }
+        }
+        else {
+            for (const auto& customer : problem.getCustomers()) {
+                for (double cost : customer.getAllocationCosts()) {
+                    add(cost);
+                }
+            }
+        }
+
+        double pairs = static_cast<double>(features.customers) * features.warehouses;
+        double mean_cost = count > 0.0 ? sum / count : 0.0;
+        features.density = pairs > 0.0 ? count / pairs : 0.0;
+        features.cost_spread = coefficientOfVariation(count, sum, sum_of_squares);
+
+        double fixed_sum = 0.0, fixed_sum_of_squares = 0.0;
+        for (const auto& warehouse : problem.getWarehouses()) {
+            fixed_sum += warehouse.getFixedCost();
+            fixed_sum_of_squares += warehouse.getFixedCost() * warehouse.getFixedCost();
+        }
+        double allocation = features.customers * mean_cost;
+        features.fixed_to_allocation = allocation > 0.0 ? fixed_sum / allocation : 0.0;
+        features.fixed_spread = coefficientOfVariation(features.warehouses, fixed_sum, fixed_sum_of_squares);
+        return features;
+    }
+
+    /**
+     * @brief The features on comparable scales (sizes and the cost ratio on a log scale), for distances between instances.
+     */
+    std::vector<double> toVector() const {
+        return { std::log(1.0 + customers), std::log(1.0 + warehouses), density, cost_spread,
+                 std::log1p(std::max(0.0, fixed_to_allocation)), fixed_spread };
+    }
+
+private:
+    static double coefficientOfVariation(double count, double sum, double sum_of_squares) {
+        if (count <= 0.0 || sum == 0.0) {
+            return 0.0;
+        }
+        double mean = sum / count;
+        double variance = std::max(0.0, sum_of_squares / count - mean * mean);
+        return std::sqrt(variance) / std::abs(mean);
+    }
+};
@@ -2,6 +2,13 @@
 #pragma once
 #include "Warehouse.hpp"
 #include "Customer.hpp"
+#include "CostMatrix.hpp"
+#include "FacilityOrder.hpp"
+#include "SparseCosts.hpp"
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
 /**
  * @brief Represents a UFL Problem instance.
@@ -21,6 +28,44 @@ public:
         customers.push_back(cust);
     }
 
+    void addCustomer(Customer&& cust) {
+        customers.push_back(std::move(cust));
+    }
+
+    /**
+     * @brief Appends a customer to a loaded problem and returns its index. Dense problems only.
+     */
+    int insertCustomer(Customer&& customer) {
+        requireDense();
+        if (static_cast<int>(customer.getAllocationCosts().size()) != num_warehouses) {
+            throw std::invalid_argument("Customer costs do not match the number of warehouses");
+        }
+        customers.push_back(std::move(customer));
+        search_costs.reset();
+        facility_order.reset();
+        return num_customers++;
+    }
+
+    /**
+     * @brief Removes customer j from a loaded problem; the last customer takes index j. Dense problems only.
+     */
+    void removeCustomer(int j) {
+        requireDense();
+        if (j < 0 || j >= num_customers) {
+            throw std::out_of_range("Customer index out of range");
+        }
+        customers[j] = std::move(customers.back());
+        customers.pop_back();
+        --num_customers;
+        search_costs.reset();
+        facility_order.reset();
+    }
+
+    void setFixedCost(int i, double cost) {
+        warehouses[i].setFixedCost(cost);
+        search_costs.reset();
+    }
+
     int getNumberOfCustomers() const {
         return num_customers;
     }
@@ -36,9 +81,159 @@ public:
     const std::vector<Customer>& getCustomers() const {
         return customers;
     }
+
+    /**
+     * @brief Replaces the allocation costs with a sparse matrix. The customers' dense cost
+     * vectors are released, and every pair missing from the matrix costs infinity.
+     */
+    void setSparseCosts(SparseCosts&& costs) {
+        if (costs.getNumberOfCustomers() != static_cast<int>(customers.size()) || costs.getNumberOfWarehouses() != num_warehouses) {
+            throw std::invalid_argument("Sparse cost matrix does not match the problem size");
+        }
+        sparse_costs = std::make_shared<const SparseCosts>(std::move(costs));
+        for (auto& customer : customers) {
+            customer = Customer(customer.getDemand(), std::vector<double>());
+        }
+        search_costs.reset();
+        facility_order.reset();
+    }
+
+    /**
+     * @brief Keeps only the nearest_facilities cheapest facilities of every customer.
+     */
+    void sparsify(int nearest_facilities) {
+        setSparseCosts(SparseCosts::fromDense(customers, num_warehouses, nearest_facilities));
+    }
+
+    bool isSparse() const {
+        return sparse_costs != nullptr;
+    }
+
+    /**
+     * @brief The sparse allocation costs, or nullptr if the problem is dense.
+     */
+    std::shared_ptr<const SparseCosts> getSparseCosts() const {
+        return sparse_costs;
+    }
+
+    /**
+     * @brief Cost of serving customer j from warehouse i; infinite for a pair a sparse problem does not store.
+     */
+    double getAllocationCost(int j, int i) const {
+        return sparse_costs ? sparse_costs->getCost(j, i) : customers[j].getAllocationCosts()[i];
+    }
+
+    /**
+     * @brief Stores a copy of the allocation costs in the given precision for the search to scan.
+     * Call it once the instance is fully loaded. Sparse problems always search in double precision.
+     *
+     * @param scale Fixed-point scale; 0 picks the largest power of ten that fits the type.
+     */
+    void setSearchPrecision(CostPrecision precision, double scale = 0.0) {
+        search_costs = sparse_costs ? std::make_shared<SparseCostMatrix>(sparse_costs, warehouses)
+                                    : makeCostMatrix(customers, warehouses, precision, scale);
+    }
+
+    CostPrecision getSearchPrecision() const {
+        return search_costs ? search_costs->getPrecision() : CostPrecision::Double;
+    }
+
+    /**
+     * @brief The cost matrix the search should scan. Built in double precision if no precision was set.
+     */
+    std::shared_ptr<const CostMatrix> getSearchCosts() const {
+        if (search_costs) {
+            return search_costs;
+        }
+        if (sparse_costs) {
+            return std::make_shared<SparseCostMatrix>(sparse_costs, warehouses);
+        }
+        return makeCostMatrix(customers, warehouses, CostPrecision::Double);
+    }
+
+    /**
+     * @brief Sorts every customer's facilities by allocation cost, in parallel over customer blocks.
+     * Call it once the instance is fully loaded. Does nothing for a sparse problem, whose rows are already sorted.
+     */
+    void buildFacilityOrder(int number_of_threads = 0) {
+        if (sparse_costs) {
+            return;
+        }
+        facility_order = std::make_shared<const FacilityOrder>(customers, num_warehouses, number_of_threads);
+    }
+
+    /**
+     * @brief The sorted facility order, or nullptr if buildFacilityOrder() was not called.
+     */
+    std::shared_ptr<const FacilityOrder> getFacilityOrder() const {
+        return facility_order;
+    }
+
+    /**
+     * @brief Assigns every customer to its cheapest open warehouse, in exact double precision.
+     * A customer of a sparse problem with no open warehouse in its row gets -1.
+     */
+    std::vector<std::pair<int, int>> assignToNearest(const std::vector<bool>& open) const {
+        std::vector<std::pair<int, int>> assignments;
+        assignments.reserve(customers.size());
+
+        if (sparse_costs) {
+            for (int j = 0; j < num_customers; ++j) {
+                assignments.emplace_back(j, sparse_costs->nearestOpen(j, [&open](int i) { return open[i]; }));
+            }
+            return assignments;
+        }
+
+        for (std::size_t j = 0; j < customers.size(); ++j) {
+            const auto& costs = customers[j].getAllocationCosts();
+            int best_warehouse = -1;
+            double best_cost = std::numeric_limits<double>::max();
+            for (std::size_t i = 0; i < open.size(); ++i) {
+                if (open[i] && costs[i] < best_cost) {
+                    best_cost = costs[i];
+                    best_warehouse = static_cast<int>(i);
+                }
+            }
+            assignments.emplace_back(static_cast<int>(j), best_warehouse);
+        }
+        return assignments;
+    }
+
+    /**
+     * @brief Exact double cost of an assignment: allocation costs plus the fixed cost of every warehouse used.
+     * Infinite if a customer is unassigned or assigned to a pair a sparse problem does not store.
+     */
+    double evaluate(const std::vector<std::pair<int, int>>& assignments) const {
+        std::vector<bool> used(warehouses.size(), false);
+        double cost = 0.0;
+        for (const auto& assignment : assignments) {
+            if (assignment.second < 0) {
+                return std::numeric_limits<double>::infinity();
+            }
+            cost += getAllocationCost(assignment.first, assignment.second);
+            used[assignment.second] = true;
+        }
+        for (std::size_t i = 0; i < warehouses.size(); ++i) {
+            if (used[i]) {
+                cost += warehouses[i].getFixedCost();
+            }
+        }
+        return cost;
+    }
+
     int num_customers;
     int num_warehouses;
     std::vector<Warehouse> warehouses;
     std::vector<Customer> customers;
 
+private:
+    void requireDense() const {
+        if (sparse_costs) {
+            throw std::logic_error("Customers of a sparse problem cannot be added or removed");
+        }
+    }
+
+    std::shared_ptr<const SparseCosts> sparse_costs;
+    std::shared_ptr<const CostMatrix> search_costs;
+    std::shared_ptr<const FacilityOrder> facility_order;
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+#include "Customer.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Allocation costs in compressed sparse row form.
+ *
+ * Every customer keeps only the facilities that may serve it, sorted by increasing cost
+ * (ties by facility index, like FacilityOrder), so the first open entry of a row is the
+ * customer's nearest open facility. A pair that is not stored has an infinite cost.
+ * A column index (the customers each facility may serve) is built alongside, so opening a
+ * facility only touches the customers in its column. Memory is O(n + m + nonzeros).
+ */
+class SparseCosts {
+public:
+    using Entry = std::pair<int, double>;
+
+    SparseCosts() : number_of_warehouses(0), row_offsets(1, 0), column_offsets(1, 0) {}
+
+    /**
+     * @param rows For every customer, its (facility, cost) pairs in any order. Facilities must be distinct and in [0, m).
+     */
+    SparseCosts(int number_of_warehouses, std::vector<std::vector<Entry>>&& rows)
+        : number_of_warehouses(number_of_warehouses), row_offsets(rows.size() + 1, 0) {
+        for (std::size_t j = 0; j < rows.size(); ++j) {
+            row_offsets[j + 1] = row_offsets[j] + rows[j].size();
+        }
+        facilities.reserve(row_offsets.back());
+        costs.reserve(row_offsets.back());
+
+        column_offsets.assign(number_of_warehouses + 1, 0);
+        for (auto& row : rows) {
+            std::sort(row.begin(), row.end(), [](const Entry& a, const Entry& b) {
+                return a.second < b.second || (a.second == b.second && a.first < b.first);
+            });
+            for (const Entry& entry : row) {
+                if (entry.first < 0 || entry.first >= number_of_warehouses) {
+                    throw std::out_of_range("Sparse cost entry refers to an unknown warehouse");
+                }
+                facilities.push_back(entry.first);
+                costs.push_back(entry.second);
+                ++column_offsets[entry.first + 1];
+            }
+            std::vector<Entry>().swap(row);
+        }
+
+        for (int i = 0; i < number_of_warehouses; ++i) {
+            column_offsets[i + 1] += column_offsets[i];
+        }
+        column_customers.resize(facilities.size());
+        column_costs.resize(facilities.size());
+        std::vector<std::size_t> fill(column_offsets.begin(), column_offsets.end() - 1);
+        for (int j = 0; j < getNumberOfCustomers(); ++j) {
+            for (std::size_t e = row_offsets[j]; e < row_offsets[j + 1]; ++e) {
+                std::size_t slot = fill[facilities[e]]++;
+                column_customers[slot] = j;
+                column_costs[slot] = costs[e];
+            }
+        }
+    }
+
+    /**
+     * @brief Keeps the nearest_facilities cheapest facilities of every dense customer row.
+     */
+    static SparseCosts fromDense(const std::vector<Customer>& customers, int number_of_warehouses, int nearest_facilities) {
+        int k = std::max(1, std::min(nearest_facilities, number_of_warehouses));
+        std::vector<std::vector<Entry>> rows(customers.size());
+        std::vector<int> order(number_of_warehouses);
+
+        for (std::size_t j = 0; j < customers.size(); ++j) {
+            const auto& row = customers[j].getAllocationCosts();
+            std::iota(order.begin(), order.end(), 0);
+            std::partial_sort(order.begin(), order.begin() + k, order.end(), [&row](int a, int b) {
+                return row[a] < row[b] || (row[a] == row[b] && a < b);
+            });
+            rows[j].reserve(k);
+            for (int r = 0; r < k; ++r) {
+                rows[j].emplace_back(order[r], row[order[r]]);
+            }
+        }
+        return SparseCosts(number_of_warehouses, std::move(rows));
+    }
+
+    int getNumberOfCustomers() const { return static_cast<int>(row_offsets.size()) - 1; }
+    int getNumberOfWarehouses() const { return number_of_warehouses; }
+    std::size_t getNonZeroCount() const { return facilities.size(); }
+
+    /**
+     * @brief Customer j's entries are [rowBegin(j), rowEnd(j)) of getFacility / getCost, cheapest first.
+     */
+    std::size_t rowBegin(int j) const { return row_offsets[j]; }
+    std::size_t rowEnd(int j) const { return row_offsets[j + 1]; }
+    int getFacility(std::size_t entry) const { return facilities[entry]; }
+    double getCost(std::size_t entry) const { return costs[entry]; }
+
+    /**
+     * @brief Facility i's entries are [columnBegin(i), columnEnd(i)) of getColumnCustomer / getColumnCost, by customer.
+     */
+    std::size_t columnBegin(int i) const { return column_offsets[i]; }
+    std::size_t columnEnd(int i) const { return column_offsets[i + 1]; }
+    int getColumnCustomer(std::size_t entry) const { return column_customers[entry]; }
+    double getColumnCost(std::size_t entry) const { return column_costs[entry]; }
+
+    /**
+     * @brief Cost of serving customer j from facility i, or missing if the pair is not stored. O(row length).
+     */
+    double getCost(int j, int i, double missing = std::numeric_limits<double>::infinity()) const {
+        for (std::size_t e = row_offsets[j]; e < row_offsets[j + 1]; ++e) {
+            if (facilities[e] == i) {
+                return costs[e];
+            }
+        }
+        return missing;
+    }
+
+    /**
+     * @brief Cheapest open facility of customer j, or -1 if none of its facilities is open.
+     */
+    template <typename IsOpen>
+    int nearestOpen(int j, const IsOpen& is_open) const {
+        for (std::size_t e = row_offsets[j]; e < row_offsets[j + 1]; ++e) {
+            if (is_open(facilities[e])) {
+                return facilities[e];
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Largest stored cost of customer j, 0 for an empty row.
+     */
+    double getLargestCost(int j) const {
+        return row_offsets[j] == row_offsets[j + 1] ? 0.0 : costs[row_offsets[j + 1] - 1];
+    }
+
+private:
+    int number_of_warehouses;
+    std::vector<std::size_t> row_offsets;
+    std::vector<std::int32_t> facilities;
+    std::vector<double> costs;
+    std::vector<std::size_t> column_offsets;
+    std::vector<std::int32_t> column_customers;
+    std::vector<double> column_costs;
+};
@@ -17,4 +17,8 @@ public:
     double getFixedCost() const {
         return fixed_cost;
     }
+
+    void setFixedCost(double cost) {
+        fixed_cost = cost;
+    }
 };
\ No newline at end of file
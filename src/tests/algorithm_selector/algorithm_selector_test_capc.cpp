@@ -0,0 +1,76 @@
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/AlgorithmSelector.hpp"
+#define EXPECTED_CANDIDATE "VNS kmax=3 iterations=20"
+#define INSTANCE "capc"
+
+bool isComplete(const Problem& problem, const std::vector<std::pair<int, int>>& solution) {
+	std::vector<bool> assigned(problem.getNumberOfCustomers(), false);
+	for (const auto& assignment : solution) {
+		if (assignment.first < 0 || assignment.first >= problem.getNumberOfCustomers() || assigned[assignment.first] ||
+			assignment.second < 0 || assignment.second >= problem.getNumberOfWarehouses()) {
+			return false;
+		}
+		assigned[assignment.first] = true;
+	}
+	return solution.size() == assigned.size();
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/" INSTANCE ".txt");
+		InstanceFeatures features = InstanceFeatures::extract(problem);
+		std::cout << "n=" << features.customers << " m=" << features.warehouses << " density=" << features.density
+				  << " cost_spread=" << features.cost_spread << " fixed_to_allocation=" << features.fixed_to_allocation
+				  << " fixed_spread=" << features.fixed_spread << std::endl;
+		if (features.customers != problem.getNumberOfCustomers() || features.warehouses != problem.getNumberOfWarehouses() ||
+			features.density != 1.0) {
+			return 1;
+		}
+
+		algorithm::AlgorithmSelector training;
+		training.load("../../../src/tests/FicheirosTeste/selector_training.csv");
+
+		// Leave this instance out, so the choice comes from the other trained instances
+		algorithm::AlgorithmSelector selector;
+		selector.addDefaultCandidates();
+		for (const auto& observation : training.getObservations()) {
+			if (observation.features.toVector() != features.toVector()) {
+				selector.addObservation(observation.features, observation.candidate, observation.cost, observation.seconds);
+			}
+		}
+		if (selector.getObservations().size() == training.getObservations().size()) {
+			return 1;
+		}
+
+		// The choice follows from the observations of the other instances alone, and the candidate
+		// run for it has to assign every customer to a facility
+		auto solution = selector.solve(problem);
+		std::cout << "Selected " << selector.getSelected() << std::endl;
+		if (selector.getSelected() != EXPECTED_CANDIDATE || selector.select(features) != EXPECTED_CANDIDATE) {
+			return 1;
+		}
+		if (!isComplete(problem, solution)) {
+			return 1;
+		}
+
+		// Warm started with an assignment, which the selected engine receives as it is
+		selector.setInitialSolution(solution);
+		auto warm_solution = selector.solve(problem);
+		if (!isComplete(problem, warm_solution)) {
+			return 1;
+		}
+		std::cout << "Expected candidate selected, complete assignment returned!" << std::endl;
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
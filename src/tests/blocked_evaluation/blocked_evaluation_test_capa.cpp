@@ -0,0 +1,96 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#define BATCH_SIZE 64
+#define NEAREST_FACILITIES 50
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	return std::abs(a - b) <= epsilon * std::max(1.0, std::abs(b));
+}
+
+/**
+ * Every cost of a batch must be the cost of the same open set evaluated alone, in both the scan and the sorted walk.
+ */
+bool batchMatches(const CostMatrix& costs, const FacilityOrder& order, const std::vector<const std::vector<bool>*>& batch) {
+	std::vector<double> scanned, walked;
+	costs.evaluateBatch(batch, scanned);
+	costs.evaluateBatch(batch, order, walked);
+	if (scanned.size() != batch.size() || walked.size() != batch.size()) {
+		return false;
+	}
+	for (std::size_t b = 0; b < batch.size(); ++b) {
+		if (!isAlmostEqual(scanned[b], costs.evaluate(*batch[b]), 1e-12) || !isAlmostEqual(walked[b], costs.evaluate(*batch[b], order), 1e-12)) {
+			std::cout << "Open set " << b << ": " << scanned[b] << " and " << walked[b] << " instead of " << costs.evaluate(*batch[b]) << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capa.txt");
+		problem.buildFacilityOrder();
+		const int m = problem.getNumberOfWarehouses();
+
+		// Open sets from nearly empty to nearly full, plus one with nothing open
+		std::mt19937 generator(11);
+		std::vector<std::vector<bool>> open_sets(BATCH_SIZE, std::vector<bool>(m));
+		std::vector<const std::vector<bool>*> batch;
+		for (int b = 1; b < BATCH_SIZE; ++b) {
+			for (int i = 0; i < m; ++i) {
+				open_sets[b][i] = generator() % BATCH_SIZE <= static_cast<unsigned>(b);
+			}
+		}
+		for (const auto& open : open_sets) {
+			batch.push_back(&open);
+		}
+
+		for (CostPrecision precision : { CostPrecision::Double, CostPrecision::Float, CostPrecision::Fixed32, CostPrecision::Fixed64 }) {
+			problem.setSearchPrecision(precision);
+			if (!batchMatches(*problem.getSearchCosts(), *problem.getFacilityOrder(), batch)) {
+				return 1;
+			}
+		}
+
+		std::vector<double> costs;
+		problem.getSearchCosts()->evaluateBatch(batch, costs);
+		if (costs.front() != std::numeric_limits<double>::max()) {
+			return 1;
+		}
+
+		// One batch against the same open sets evaluated one by one
+		std::shared_ptr<const CostMatrix> search_costs = problem.getSearchCosts();
+		auto start = std::chrono::steady_clock::now();
+		for (const auto* open : batch) {
+			search_costs->evaluate(*open);
+		}
+		double one_by_one = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		start = std::chrono::steady_clock::now();
+		search_costs->evaluateBatch(batch, costs);
+		double blocked = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "One by one: " << one_by_one << " ms, blocked: " << blocked << " ms" << std::endl;
+
+		// A sparse open set leaving a customer unserved is infeasible in the batch too
+		Problem sparse = problem;
+		sparse.sparsify(NEAREST_FACILITIES);
+		FacilityOrder no_order(std::vector<Customer>(), 0);
+		if (!batchMatches(*sparse.getSearchCosts(), no_order, batch)) {
+			return 1;
+		}
+
+		std::cout << "Blocked evaluation matches every open set!" << std::endl;
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/SimulatedAnnealingAlgorithm.hpp"
+#define OPTIMAL_SOLUTION 17156454.47830
+#define FINAL_TEMPERATURE 1.0
+#define ITERATIONS_PER_TEMPERATURE 5
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capa.txt");
+
+		// Lundy-Mees reaches the final temperature after exactly its number of steps
+		algorithm::LundyMeesCooling lundy_mees(20);
+		lundy_mees.start(1000.0, FINAL_TEMPERATURE);
+		double temperature = 1000.0;
+		for (int step = 0; step < 20; ++step) {
+			temperature = lundy_mees.next(temperature, { 0.5, false });
+		}
+		if (std::abs(temperature - FINAL_TEMPERATURE) > 1e-9) {
+			return 1;
+		}
+
+		// Adaptive cooling falls faster when most moves are accepted
+		algorithm::AdaptiveCooling adaptive(0.8);
+		if (!(adaptive.next(1000.0, { 0.9, false }) < adaptive.next(1000.0, { 0.3, false }) &&
+			  adaptive.next(1000.0, { 0.3, false }) < adaptive.next(1000.0, { 0.05, false }))) {
+			return 1;
+		}
+
+		// Reheating goes back up after its patience runs out without a new best
+		algorithm::Reheating<algorithm::GeometricCooling> reheating(algorithm::GeometricCooling(0.5), 3, 0.5);
+		reheating.start(1000.0, FINAL_TEMPERATURE);
+		temperature = 1000.0;
+		for (int step = 0; step < 3; ++step) {
+			temperature = reheating.next(temperature, { 0.1, false });
+		}
+		if (temperature != 500.0) {
+			return 1;
+		}
+
+		// Every schedule, from a calibrated initial temperature, gives a complete assignment
+		std::vector<std::pair<std::string, std::shared_ptr<algorithm::Algorithm>>> annealers = {
+			{ "geometric", std::make_shared<algorithm::SimulatedAnnealingAlgorithm>(0.0, FINAL_TEMPERATURE, 0.7, ITERATIONS_PER_TEMPERATURE) },
+			{ "geometric policy", std::make_shared<algorithm::ScheduledSimulatedAnnealing<algorithm::GeometricCooling>>(
+				algorithm::GeometricCooling(0.7), 0.0, FINAL_TEMPERATURE, ITERATIONS_PER_TEMPERATURE) },
+			{ "Lundy-Mees", std::make_shared<algorithm::ScheduledSimulatedAnnealing<algorithm::LundyMeesCooling>>(
+				algorithm::LundyMeesCooling(30), 0.0, FINAL_TEMPERATURE, ITERATIONS_PER_TEMPERATURE) },
+			{ "adaptive", std::make_shared<algorithm::ScheduledSimulatedAnnealing<algorithm::AdaptiveCooling>>(
+				algorithm::AdaptiveCooling(0.7), 0.0, FINAL_TEMPERATURE, ITERATIONS_PER_TEMPERATURE) },
+			{ "adaptive with reheating", std::make_shared<algorithm::ScheduledSimulatedAnnealing<algorithm::Reheating<algorithm::AdaptiveCooling>>>(
+				algorithm::Reheating<algorithm::AdaptiveCooling>(algorithm::AdaptiveCooling(0.7), 5, 0.5, 2), 0.0, FINAL_TEMPERATURE, ITERATIONS_PER_TEMPERATURE) },
+		};
+		std::vector<double> costs;
+		for (const auto& annealer : annealers) {
+			auto solution = annealer.second->solve(problem);
+			double cost = problem.evaluate(solution);
+			std::cout << annealer.first << ": " << cost << std::endl;
+			if (solution.size() != static_cast<std::size_t>(problem.getNumberOfCustomers()) || cost < OPTIMAL_SOLUTION - 1e-3) {
+				return 1;
+			}
+			costs.push_back(cost);
+		}
+
+		// The geometric policy is the default schedule
+		if (costs[0] != costs[1]) {
+			return 1;
+		}
+
+		std::cout << "Every cooling schedule annealed!" << std::endl;
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,47 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/HillClimbingAlgorithm.hpp"
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capc.txt");
+		algorithm::HillClimbingAlgorithm hill_climbing;
+
+		double reference_cost = problem.evaluate(hill_climbing.solve(problem));
+
+		// The 64-bit fixed-point search cost of an open set must match its double cost
+		std::vector<bool> all_open(problem.getNumberOfWarehouses(), true);
+		double double_cost = problem.getSearchCosts()->evaluate(all_open);
+		problem.setSearchPrecision(CostPrecision::Fixed64);
+		if (!isAlmostEqual(problem.getSearchCosts()->evaluate(all_open), double_cost, 1e-6)) {
+			return 1;
+		}
+
+		for (CostPrecision precision : { CostPrecision::Float, CostPrecision::Fixed32, CostPrecision::Fixed64 }) {
+			problem.setSearchPrecision(precision);
+			double totalCost = problem.evaluate(hill_climbing.solve(problem));
+
+			if (!isAlmostEqual(totalCost, reference_cost)) {
+				return 1;
+			}
+		}
+
+		std::cout << "Same solution found in every precision!" << std::endl;
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error parsing file: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
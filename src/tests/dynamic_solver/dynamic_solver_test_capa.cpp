@@ -0,0 +1,90 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/BranchAndBoundAlgorithm.hpp"
+#include "../../algorithms/DynamicSolver.hpp"
+#include "../../algorithms/IncrementalEvaluator.hpp"
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+/**
+ * @brief The solver's running cost must match a from-scratch evaluation of its problem.
+ */
+bool isConsistent(const algorithm::DynamicSolver& solver) {
+	algorithm::IncrementalEvaluator fresh(solver.getProblem());
+	fresh.reset(solver.getOpenWarehouses());
+	return isAlmostEqual(solver.getCost(), fresh.getCost(), 1e-3);
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capa.txt");
+
+		// Start from the exact optimum, whose cost the solver must take over
+		algorithm::BranchAndBoundAlgorithm branch_and_bound;
+		auto optimum = branch_and_bound.solve(problem);
+		const double optimalCost = problem.evaluate(optimum);
+		algorithm::DynamicSolver solver(problem);
+		solver.setSolution(optimum);
+		if (!isAlmostEqual(solver.getCost(), optimalCost)) {
+			return 1;
+		}
+
+		// Customers leave and come back: the customer set is the same, so the optimum is too
+		std::vector<Customer> removed;
+		for (int step = 0; step < 10; ++step) {
+			int j = (step * 37) % solver.getProblem().getNumberOfCustomers();
+			removed.push_back(solver.getProblem().getCustomers()[j]);
+			solver.removeCustomer(j);
+			solver.reoptimise();
+			if (!isConsistent(solver)) {
+				return 1;
+			}
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (const Customer& customer : removed) {
+			solver.addCustomer(customer);
+		}
+		solver.reoptimise();
+		double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "Re-optimised after re-adding customers in " << elapsed << " ms" << std::endl;
+		if (!isConsistent(solver) || solver.getProblem().getNumberOfCustomers() != problem.getNumberOfCustomers()) {
+			return 1;
+		}
+
+		// Making an open facility expensive must close it
+		std::vector<bool> open = solver.getOpenWarehouses();
+		int expensive = 0;
+		while (!open[expensive]) {
+			++expensive;
+		}
+		solver.setFixedCost(expensive, 1e12);
+		solver.reoptimise();
+		if (solver.getOpenWarehouses()[expensive] || !isConsistent(solver)) {
+			return 1;
+		}
+		solver.setFixedCost(expensive, problem.getWarehouses()[expensive].getFixedCost());
+		solver.reoptimise();
+
+		double totalCost = solver.getProblem().evaluate(solver.getAssignments());
+		if (isAlmostEqual(totalCost, solver.getCost()) && totalCost <= optimalCost + 0.1 * optimalCost) {
+			std::cout << "Solution kept up to date!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error parsing file: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
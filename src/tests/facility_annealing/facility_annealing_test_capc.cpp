@@ -0,0 +1,39 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/SimulatedAnnealingAlgorithm.hpp"
+#define OPTIMAL_SOLUTION 11505594.32878
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capc.txt");
+
+		// Flips from every facility open, at a calibrated initial temperature
+		algorithm::SimulatedAnnealingAlgorithm simulated_annealing(0.0, 1.0, 0.95, 1000, 30, algorithm::SimulatedAnnealingAlgorithm::MoveSpace::Facilities);
+		simulated_annealing.setSeed(4);
+		auto start = std::chrono::steady_clock::now();
+		auto solution = simulated_annealing.solve(problem);
+		std::cout << "Facility annealing: " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+
+		double totalCost = problem.evaluate(solution);
+		if (solution.size() == static_cast<std::size_t>(problem.getNumberOfCustomers()) && isAlmostEqual(totalCost, OPTIMAL_SOLUTION)) {
+			std::cout << "Optimal solution found!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
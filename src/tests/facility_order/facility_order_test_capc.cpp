@@ -0,0 +1,72 @@
+#include <iostream>
+#include <unordered_map>
+#include <iomanip>
+#include <cmath>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/TabuSearchAlgorithm.hpp"
+#include <random>
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capc.txt");
+		Problem scanned = problem;
+		problem.buildFacilityOrder();
+
+		// Walking the sorted facilities must give the same cost as scanning every facility
+		std::shared_ptr<const CostMatrix> costs = problem.getSearchCosts();
+		std::mt19937 generator(7);
+		for (int sample = 0; sample < 20; ++sample) {
+			std::vector<bool> open(problem.getNumberOfWarehouses());
+			for (int i = 0; i < problem.getNumberOfWarehouses(); ++i) {
+				open[i] = generator() % (sample + 2) == 0;
+			}
+			if (!isAlmostEqual(costs->evaluate(open, *problem.getFacilityOrder()), costs->evaluate(open), 1e-6)) {
+				return 1;
+			}
+		}
+
+		// With the same seed, the search must end at the same cost whether it walks the order or scans
+		algorithm::TabuSearchAlgorithm scanned_search(10000, 10, 10000);
+		double scannedCost = scanned.evaluate(scanned_search.solve(scanned));
+
+		algorithm::TabuSearchAlgorithm tabu_search(10000, 10, 10000);
+
+		auto solution = tabu_search.solve(problem);
+
+		double totalAllocationCost = 0.0;
+		double totalFixedCost = 0.0;
+
+		std::unordered_map<int, bool> usedWarehouses;
+
+		for (const auto& assignment : solution) {
+			totalAllocationCost += problem.getCustomers()[assignment.first].getAllocationCosts()[assignment.second];
+			usedWarehouses[assignment.second] = true;
+		}
+
+		for (const auto& warehouse : usedWarehouses) {
+			if (warehouse.second) {
+				totalFixedCost += problem.getWarehouses()[warehouse.first].getFixedCost();
+			}
+		}
+
+		double totalCost = totalAllocationCost + totalFixedCost;
+		if (isAlmostEqual(totalCost, scannedCost)) {
+			std::cout << "Same solution with the facility order!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error parsing file: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
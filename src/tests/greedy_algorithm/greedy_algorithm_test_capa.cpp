@@ -0,0 +1,57 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/GreedyAlgorithm.hpp"
+#include "../../algorithms/VariableNeighbourhoodSearch.hpp"
+#define OPTIMAL_SOLUTION 17156454.47830
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capa.txt");
+
+		const char* names[] = { "ADD", "DROP", "Kuehn-Hamburger" };
+		const algorithm::GreedyAlgorithm::Mode modes[] = { algorithm::GreedyAlgorithm::Mode::Add, algorithm::GreedyAlgorithm::Mode::Drop,
+														   algorithm::GreedyAlgorithm::Mode::KuehnHamburger };
+		std::vector<bool> kuehn_hamburger;
+		for (int k = 0; k < 3; ++k) {
+			algorithm::GreedyAlgorithm greedy(modes[k]);
+			auto start = std::chrono::steady_clock::now();
+			auto solution = greedy.solve(problem);
+			double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			double cost = problem.evaluate(solution);
+			std::cout << names[k] << ": " << cost << " in " << milliseconds << " ms" << std::endl;
+
+			// Greedy solutions are feasible and cannot beat the optimum
+			if (solution.size() != static_cast<std::size_t>(problem.getNumberOfCustomers()) || cost < OPTIMAL_SOLUTION - 1e-3) {
+				return 1;
+			}
+			if (modes[k] == algorithm::GreedyAlgorithm::Mode::KuehnHamburger) {
+				kuehn_hamburger = greedy.construct(problem);
+			}
+		}
+
+		// Fed to a local search as its start
+		algorithm::VariableNeighbourhoodSearch vns(5, 50);
+		vns.setInitialSolution(kuehn_hamburger);
+		double totalCost = problem.evaluate(vns.solve(problem));
+		if (isAlmostEqual(totalCost, OPTIMAL_SOLUTION)) {
+			std::cout << "Optimal solution found!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
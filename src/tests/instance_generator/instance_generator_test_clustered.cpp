@@ -0,0 +1,65 @@
+#include <iostream>
+#include <cstdio>
+#include "../../misc/InstanceGenerator.hpp"
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+
+bool isSameInstance(const Problem& a, const Problem& b) {
+	if (a.getNumberOfCustomers() != b.getNumberOfCustomers() || a.getNumberOfWarehouses() != b.getNumberOfWarehouses()) {
+		return false;
+	}
+	for (int i = 0; i < a.getNumberOfWarehouses(); ++i) {
+		if (a.getWarehouses()[i].getFixedCost() != b.getWarehouses()[i].getFixedCost()) {
+			return false;
+		}
+	}
+	for (int j = 0; j < a.getNumberOfCustomers(); ++j) {
+		if (a.getCustomers()[j].getDemand() != b.getCustomers()[j].getDemand() ||
+			a.getCustomers()[j].getAllocationCosts() != b.getCustomers()[j].getAllocationCosts()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	try {
+		miscellaneous::GeneratorSettings settings;
+		settings.family = miscellaneous::InstanceFamily::Clustered;
+		settings.number_of_customers = 300;
+		settings.number_of_warehouses = 120;
+		settings.seed = 42;
+
+		Problem problem = miscellaneous::InstanceGenerator::generate(settings);
+		if (!isSameInstance(problem, miscellaneous::InstanceGenerator::generate(settings))) {
+			std::cout << "Same seed gave a different instance" << std::endl;
+			return 1;
+		}
+
+		settings.seed = 43;
+		if (isSameInstance(problem, miscellaneous::InstanceGenerator::generate(settings))) {
+			std::cout << "Different seeds gave the same instance" << std::endl;
+			return 1;
+		}
+
+		const char* path = "instance_generator_test_clustered.txt";
+		miscellaneous::InstanceGenerator::writeORLib(problem, path);
+		miscellaneous::ORLibParser parser;
+		Problem parsed = parser.parse(path);
+		std::remove(path);
+
+		if (!isSameInstance(problem, parsed)) {
+			std::cout << "Written instance does not parse back exactly" << std::endl;
+			return 1;
+		}
+
+		std::cout << "Instance generated deterministically and read back exactly!" << std::endl;
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error generating instance: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <iostream>
+#include <unordered_map>
+#include <iomanip>
+#include <cmath>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/ElitePool.hpp"
+#include "../../algorithms/GeneticAlgorithm.hpp"
+#include "../../algorithms/IncrementalEvaluator.hpp"
+#include "../../algorithms/PathRelinking.hpp"
+#include "../../algorithms/TabuSearchAlgorithm.hpp"
+#define OPTIMAL_SOLUTION 11505594.32878
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capc.txt");
+		algorithm::ElitePool pool(8, 2);
+
+		algorithm::GeneticAlgorithm genetic_algorithm(20, 5);
+		genetic_algorithm.shareElitePool(&pool);
+		genetic_algorithm.solve(problem);
+		algorithm::TabuSearchAlgorithm tabu_search(100, 10, 100);
+		tabu_search.shareElitePool(&pool);
+		tabu_search.solve(problem);
+
+		algorithm::PathRelinking path_relinking;
+		algorithm::ElitePool::Entry best = path_relinking.run(problem, pool);
+
+		algorithm::IncrementalEvaluator evaluator(problem);
+		evaluator.reset(best.open.toVector());
+		auto solution = evaluator.getAssignments();
+
+		double totalAllocationCost = 0.0;
+		double totalFixedCost = 0.0;
+
+		std::unordered_map<int, bool> usedWarehouses;
+
+		for (const auto& assignment : solution) {
+			totalAllocationCost += problem.getCustomers()[assignment.first].getAllocationCosts()[assignment.second];
+			usedWarehouses[assignment.second] = true;
+		}
+
+		for (const auto& warehouse : usedWarehouses) {
+			if (warehouse.second) {
+				totalFixedCost += problem.getWarehouses()[warehouse.first].getFixedCost();
+			}
+		}
+
+		double totalCost = totalAllocationCost + totalFixedCost;
+		if (isAlmostEqual(totalCost, OPTIMAL_SOLUTION)) {
+			std::cout << "Optimal solution found!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error parsing file: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
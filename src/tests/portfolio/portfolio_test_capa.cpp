@@ -0,0 +1,75 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <memory>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/GRASP.hpp"
+#include "../../algorithms/PortfolioAlgorithm.hpp"
+#define OPTIMAL_SOLUTION 17156454.47830
+#define TIME_LIMIT 15.0
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capa.txt");
+
+		algorithm::PortfolioAlgorithm portfolio(TIME_LIMIT);
+		portfolio.addDefaultEngines();
+
+		auto solution = portfolio.solve(problem);
+
+		// The winner must be an engine whose best is the returned cost
+		bool winner_found = false;
+		for (const auto& result : portfolio.getResults()) {
+			std::cout << result.name << ": " << std::fixed << std::setprecision(5) << result.cost << " after " << result.seconds
+					  << " s in " << result.runs << " runs" << std::endl;
+			if (result.name == portfolio.getWinner() && std::abs(result.cost - problem.evaluate(solution)) < 1e-3) {
+				winner_found = true;
+			}
+		}
+		if (!winner_found) {
+			return 1;
+		}
+
+		double totalCost = problem.evaluate(solution);
+		if (isAlmostEqual(totalCost, OPTIMAL_SOLUTION)) {
+			// Started from the optimum, no engine can set the incumbent, so none may be named the winner
+			algorithm::PortfolioAlgorithm warm_portfolio(TIME_LIMIT);
+			auto grasp = std::make_shared<algorithm::GRASPAlgorithm>(0.5, 10);
+			algorithm::SharedIncumbent grasp_incumbent;
+			grasp->shareIncumbent(&grasp_incumbent);
+			grasp->setInitialSolution(solution);
+			grasp->setSeed(5);
+			warm_portfolio.addEngine("GRASP", grasp);
+			warm_portfolio.setInitialSolution(solution);
+			warm_portfolio.solve(problem);
+			if (!warm_portfolio.getWinner().empty()) {
+				std::cout << "Warm start credited to " << warm_portfolio.getWinner() << std::endl;
+				return 1;
+			}
+
+			// The engine comes back configured as it was added
+			if (grasp->getSharedIncumbent() != &grasp_incumbent || grasp->getStopFlag() != nullptr ||
+				!grasp->hasInitialSolution() || grasp->getSeed() != 5) {
+				std::cout << "Engine configuration not restored" << std::endl;
+				return 1;
+			}
+
+			std::cout << "Optimal solution found by " << portfolio.getWinner() << "!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error parsing file: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
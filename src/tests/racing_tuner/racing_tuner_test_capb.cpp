@@ -0,0 +1,76 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/BranchAndBoundAlgorithm.hpp"
+#include "../../algorithms/CrowSearchAlgorithm.hpp"
+#include "../../algorithms/HillClimbingAlgorithm.hpp"
+#include "../../algorithms/RacingTuner.hpp"
+#include "../../algorithms/VariableNeighbourhoodSearch.hpp"
+#define MAXIMUM_GAP 0.01
+#define INSTANCE "capb"
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		const std::string directory = "../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/";
+		auto problem = std::make_shared<const Problem>(parser.parse(directory + "a-c/" INSTANCE ".txt"));
+
+		algorithm::RacingTuner tuner(0, 0.0, 3);
+		tuner.addConfiguration("HC", [] { return std::make_shared<algorithm::HillClimbingAlgorithm>(); });
+		// Eight evaluations are far too few; the race has to drop this one
+		tuner.addConfiguration("CSA population=4", [] { return std::make_shared<algorithm::CrowSearchAlgorithm>(4, 0.1, 8); });
+		for (int k_max : { 1, 3, 5 }) {
+			tuner.addConfiguration("VNS kmax=" + std::to_string(k_max), [k_max] { return std::make_shared<algorithm::VariableNeighbourhoodSearch>(k_max, 20); });
+		}
+		for (const char* name : { "100/cap101", "100/cap102", "100/cap103", "100/cap104", "130/cap131", "130/cap132", "130/cap133", "130/cap134" }) {
+			tuner.addInstance("cap", std::make_shared<const Problem>(parser.parse(directory + name + ".txt")));
+		}
+		tuner.addInstance("cap", problem);
+
+		algorithm::RacingTuner::RaceResult race = tuner.race("cap");
+		bool best_survived = false;
+		bool weak_dropped = false;
+		for (const auto& configuration : race.configurations) {
+			std::cout << configuration.name << ": " << configuration.runs << " runs, mean rank " << configuration.mean_rank
+					  << ", mean gap " << configuration.mean_gap << ", dropped after " << configuration.eliminated_after << std::endl;
+			if (configuration.name == race.best) {
+				best_survived = configuration.eliminated_after < 0 && configuration.runs == 9;
+			}
+			if (configuration.name == "CSA population=4") {
+				weak_dropped = configuration.eliminated_after > 0 && configuration.eliminated_after < 9;
+			}
+			// A dropped configuration is not run again
+			if (configuration.eliminated_after >= 0 && configuration.runs != configuration.eliminated_after) {
+				return 1;
+			}
+		}
+		if (!best_survived || !weak_dropped) {
+			return 1;
+		}
+
+		// The winning configuration must come within MAXIMUM_GAP of the exact optimum of the instance
+		int k_max = race.best.compare(0, 3, "VNS") != 0 ? 0 : race.best.back() - '0';
+		if (k_max == 0) {
+			return 1;
+		}
+		algorithm::BranchAndBoundAlgorithm branch_and_bound;
+		double optimum = problem->evaluate(branch_and_bound.solve(*problem));
+		algorithm::VariableNeighbourhoodSearch vns(k_max, 20);
+		double totalCost = problem->evaluate(vns.solve(*problem));
+		double gap = (totalCost - optimum) / optimum;
+		std::cout << race.best << " gap to the optimum: " << gap << std::endl;
+		if (gap <= MAXIMUM_GAP) {
+			std::cout << "Solution within " << MAXIMUM_GAP * 100 << "% of the optimum with " << race.best << "!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,50 @@
+#include <iostream>
+#include <cmath>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/GRASP.hpp"
+#define OPTIMAL_SOLUTION 12979071.58143
+#define ITERATIONS 10
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capb.txt");
+
+		algorithm::GRASP grasp(algorithm::GRASP::defaultReactiveAlphas(), ITERATIONS);
+		grasp.setSeed(1);
+		auto solution = grasp.solve(problem);
+
+		// The draw probabilities must stay a distribution over the alpha values
+		double total = 0.0;
+		for (double probability : grasp.getAlphaProbabilities()) {
+			std::cout << probability << " ";
+			if (probability < 0.0) {
+				return 1;
+			}
+			total += probability;
+		}
+		std::cout << std::endl;
+		if (grasp.getAlphaProbabilities().size() != algorithm::GRASP::defaultReactiveAlphas().size() || std::abs(total - 1.0) > 1e-9) {
+			return 1;
+		}
+
+		double totalCost = problem.evaluate(solution);
+		if (isAlmostEqual(totalCost, OPTIMAL_SOLUTION)) {
+			std::cout << "Optimal solution found!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
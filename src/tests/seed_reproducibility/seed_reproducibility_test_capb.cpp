@@ -0,0 +1,57 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/CrowSearchAlgorithm.hpp"
+#include "../../algorithms/GRASP.hpp"
+#include "../../algorithms/GeneticAlgorithm.hpp"
+#include "../../algorithms/PortfolioAlgorithm.hpp"
+#include "../../algorithms/SimulatedAnnealingAlgorithm.hpp"
+#define SEED 20240617
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capb.txt");
+
+		std::vector<std::pair<std::string, std::shared_ptr<algorithm::Algorithm>>> algorithms = {
+			{ "SA", std::make_shared<algorithm::SimulatedAnnealingAlgorithm>(1000, 100, 0.5, 5) },
+			{ "CSA", std::make_shared<algorithm::CrowSearchAlgorithm>(50, 0.1, 2000) },
+			{ "Reactive GRASP", std::make_shared<algorithm::GRASPAlgorithm>(algorithm::GRASP::defaultReactiveAlphas(), 10) },
+			{ "GA", std::make_shared<algorithm::GeneticAlgorithm>(20, 10) },
+		};
+
+		// The same seed replays a solve exactly
+		for (const auto& entry : algorithms) {
+			entry.second->setSeed(SEED);
+			std::vector<std::pair<int, int>> first = entry.second->solve(problem);
+			std::vector<std::pair<int, int>> second = entry.second->solve(problem);
+			std::cout << entry.first << ": " << problem.evaluate(first) << " and " << problem.evaluate(second) << std::endl;
+			if (first != second) {
+				return 1;
+			}
+		}
+
+		// A portfolio gives every engine its own stream and puts the engines' own seeds back afterwards
+		algorithm::PortfolioAlgorithm portfolio;
+		portfolio.setSeed(SEED);
+		portfolio.addEngine(algorithms[2].first, algorithms[2].second);
+		portfolio.addEngine(algorithms[3].first, algorithms[3].second);
+		portfolio.solve(problem);
+		if (algorithms[2].second->getSeed() != SEED || algorithms[3].second->getSeed() != SEED) {
+			return 1;
+		}
+
+		std::cout << "Every seeded solve was reproduced!" << std::endl;
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <limits>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/BranchAndBoundAlgorithm.hpp"
+#include "../../algorithms/IncrementalEvaluator.hpp"
+#include "../../algorithms/Neighbourhood.hpp"
+#include "../../algorithms/TabuSearchAlgorithm.hpp"
+#include <random>
+#define NEAREST_FACILITIES 50
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem dense = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capc.txt");
+		Problem problem = dense;
+		problem.sparsify(NEAREST_FACILITIES);
+
+		if (!problem.isSparse() || problem.getSparseCosts()->getNonZeroCount() != static_cast<std::size_t>(problem.getNumberOfCustomers()) * NEAREST_FACILITIES) {
+			return 1;
+		}
+
+		// Whenever every customer has an open facility among its kept ones, that facility is its nearest overall
+		std::shared_ptr<const CostMatrix> dense_costs = dense.getSearchCosts();
+		std::shared_ptr<const CostMatrix> sparse_costs = problem.getSearchCosts();
+		algorithm::IncrementalEvaluator dense_evaluator(dense);
+		algorithm::IncrementalEvaluator sparse_evaluator(problem);
+		std::mt19937 generator(7);
+		int feasible = 0;
+		for (int sample = 0; sample < 20; ++sample) {
+			std::vector<bool> open(problem.getNumberOfWarehouses());
+			for (int i = 0; i < problem.getNumberOfWarehouses(); ++i) {
+				open[i] = generator() % (sample % 4 + 2) == 0;
+			}
+			double cost = sparse_costs->evaluate(open);
+			if (cost == std::numeric_limits<double>::max()) {
+				continue;
+			}
+			++feasible;
+			if (!isAlmostEqual(cost, dense_costs->evaluate(open), 1e-6)) {
+				return 1;
+			}
+
+			// Flip deltas from the nearest and second-nearest lists must agree with the dense evaluator
+			dense_evaluator.reset(open);
+			sparse_evaluator.reset(open);
+			std::vector<double> dense_deltas, sparse_deltas;
+			dense_evaluator.computeFlipDeltas(dense_deltas);
+			sparse_evaluator.computeFlipDeltas(sparse_deltas);
+			for (int i = 0; i < problem.getNumberOfWarehouses(); ++i) {
+				if (open[i] && sparse_evaluator.flipDelta(i) > sparse_evaluator.getUnservedCost() / 2) {
+					continue;
+				}
+				if (std::abs(sparse_deltas[i] - dense_deltas[i]) > 1e-6 || std::abs(sparse_evaluator.flipDelta(i) - dense_deltas[i]) > 1e-6) {
+					std::cout << "Flip delta mismatch at facility " << i << std::endl;
+					return 1;
+				}
+			}
+		}
+		if (feasible == 0) {
+			return 1;
+		}
+
+		// A single open facility that customer 0 cannot reach: the best swap closes it, priced exactly
+		const SparseCosts& sparse = *problem.getSparseCosts();
+		std::vector<bool> reachable(problem.getNumberOfWarehouses(), false);
+		for (std::size_t e = sparse.rowBegin(0); e < sparse.rowEnd(0); ++e) {
+			reachable[sparse.getFacility(e)] = true;
+		}
+		int unreachable = static_cast<int>(std::find(reachable.begin(), reachable.end(), false) - reachable.begin());
+		std::vector<bool> single(problem.getNumberOfWarehouses(), false);
+		single[unreachable] = true;
+		sparse_evaluator.reset(single);
+		algorithm::SwapNeighbourhood swap(sparse_evaluator);
+		algorithm::Move move = swap.findBestMove(sparse_evaluator);
+		double best_delta = std::numeric_limits<double>::infinity();
+		for (int b = 0; b < problem.getNumberOfWarehouses(); ++b) {
+			if (b != unreachable) {
+				std::vector<bool> swapped(problem.getNumberOfWarehouses(), false);
+				swapped[b] = true;
+				algorithm::IncrementalEvaluator swapped_evaluator(problem);
+				swapped_evaluator.reset(swapped);
+				best_delta = std::min(best_delta, swapped_evaluator.getCost() - sparse_evaluator.getCost());
+			}
+		}
+		if (move.close_facility != unreachable || move.open_facility == -1 ||
+			std::abs(move.delta - best_delta) > 1e-9 * std::max(1.0, std::abs(sparse_evaluator.getCost()))) {
+			std::cout << "Single-facility swap mismatch" << std::endl;
+			return 1;
+		}
+
+		// The optimum of this instance only uses kept pairs, so the exact search, which walks only the
+		// stored rows of the sparse problem, must prove the dense optimum again
+		algorithm::BranchAndBoundAlgorithm dense_branch_and_bound;
+		algorithm::BranchAndBoundAlgorithm sparse_branch_and_bound;
+		double denseOptimum = dense.evaluate(dense_branch_and_bound.solve(dense));
+		if (!isAlmostEqual(problem.evaluate(sparse_branch_and_bound.solve(problem)), denseOptimum)) {
+			std::cout << "Sparse branch-and-bound missed the optimum" << std::endl;
+			return 1;
+		}
+
+		// With the same seed, the search must end at the same cost on the kept costs as on all of them
+		algorithm::TabuSearchAlgorithm dense_search(10000, 10, 10000);
+		double denseCost = dense.evaluate(dense_search.solve(dense));
+
+		algorithm::TabuSearchAlgorithm tabu_search(10000, 10, 10000);
+
+		auto solution = tabu_search.solve(problem);
+
+		double totalCost = problem.evaluate(solution);
+		if (isAlmostEqual(totalCost, denseCost)) {
+			std::cout << "Same solution with the sparse costs!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error parsing file: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "../../misc/ORLibParser.hpp"
+#include "../../problem/Problem.hpp"
+#include "../../algorithms/BranchAndBoundAlgorithm.hpp"
+#include "../../algorithms/CrowSearchAlgorithm.hpp"
+#include "../../algorithms/GRASP.hpp"
+#include "../../algorithms/GeneticAlgorithm.hpp"
+#include "../../algorithms/HillClimbingAlgorithm.hpp"
+#include "../../algorithms/SimulatedAnnealingAlgorithm.hpp"
+#include "../../algorithms/TabuSearchAlgorithm.hpp"
+#include "../../algorithms/VariableNeighbourhoodSearch.hpp"
+
+bool isAlmostEqual(double a, double b, double epsilon = 1e-3) {
+	std::cout << std::abs(a - b) << std::endl;
+	return std::abs(a - b) < epsilon;
+}
+
+int main() {
+	miscellaneous::ORLibParser parser;
+	try {
+		Problem problem = parser.parse("../../../src/tests/FicheirosTeste/ORLIB/ORLIB-uncap/a-c/capb.txt");
+
+		algorithm::BranchAndBoundAlgorithm branch_and_bound;
+		auto optimum = branch_and_bound.solve(problem);
+		const double optimalCost = problem.evaluate(optimum);
+
+		// Every algorithm seeded with the optimum, on a budget far too small to find it cold, must keep it
+		std::vector<std::unique_ptr<algorithm::Algorithm>> algorithms;
+		algorithms.emplace_back(new algorithm::HillClimbingAlgorithm());
+		algorithms.emplace_back(new algorithm::TabuSearchAlgorithm(10, 10, 10));
+		algorithms.emplace_back(new algorithm::VariableNeighbourhoodSearch(2, 2));
+		algorithms.emplace_back(new algorithm::GeneticAlgorithm(4, 1));
+		algorithms.emplace_back(new algorithm::CrowSearchAlgorithm(4, 0.1, 8));
+		algorithms.emplace_back(new algorithm::SimulatedAnnealingAlgorithm(1.0, 0.9, 0.5, 1));
+		algorithms.emplace_back(new algorithm::BranchAndBoundAlgorithm(1));
+
+		for (auto& solver : algorithms) {
+			solver->setInitialSolution(optimum);
+			if (!isAlmostEqual(problem.evaluate(solver->solve(problem)), optimalCost)) {
+				return 1;
+			}
+		}
+
+		algorithm::GRASP grasp(0.5);
+		std::vector<bool> open(problem.getNumberOfWarehouses(), false);
+		for (const auto& assignment : optimum) {
+			open[assignment.second] = true;
+		}
+		grasp.setInitialSolution(open);
+
+		double totalCost = problem.evaluate(grasp.solve(problem));
+		if (isAlmostEqual(totalCost, optimalCost)) {
+			std::cout << "Warm starts kept the optimum!" << std::endl;
+			return 0;
+		}
+		return 1;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error parsing file: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}